@@ -1,106 +1,46 @@
 #include "HpPowerUp.h"
+#include "Core/AssetCache.h"
+#include "Core/RenderBackend.h"
+#include "Core/RenderQueue.h"
+#include "Core/VoicePool.h"
 
-void HpPowerUp::screenLimitLogic()
+HpPowerUp::HpPowerUp(const char spriteUrl[], const char soundfxUrl[]) : Entity{ Vector2{ 0, 0 } }
 {
-	if (active)
-	{
-		// Collision logic: meteor vs wall
-		if (position.x > GetScreenWidth() + radius) position.x = -radius;
-		else if (position.x < 0 - radius) position.x = GetScreenWidth() + radius;
-		if (position.y > GetScreenHeight() + radius) position.y = -radius;
-		else if (position.y < 0 - radius) position.y = GetScreenHeight() + radius;
-	}
-}
-
-void HpPowerUp::movement()
-{
-	if (active)
-	{
-		// Movement
-		position.x += speed.x * GetFrameTime();
-		position.y += speed.y * GetFrameTime();
-	}
-}
-
-void HpPowerUp::updateTimer()
-{
-	if (!active)
-	{
-		if (timer > 0)
-		{
-			timer -= GetFrameTime();
-		}
-		else
-		{
-			this->setSpeedByAngle(GetRandomValue(0, 360));
-			setActive(true);
-		}
-	}
-}
-
-HpPowerUp::HpPowerUp(Vector2 position, const char spriteUrl[], const char soundfxUrl[], Vector2 speed, float maxSpeed, float rotation, float radius, bool active) : Entity{ position }
-{
-	this->sprite = LoadTexture(spriteUrl);
-	this->soundfx = LoadSound(soundfxUrl);
-	this->speed = speed;
-	this->maxSpeed = maxSpeed;
-	this->rotation = rotation;
-	this->radius = radius;
-	this->active = active;
+	this->sprite = AssetCache::instance().loadSprite(spriteUrl);
+	this->sample = VoicePool::instance().addSample(soundfxUrl);
 }
 
 HpPowerUp::~HpPowerUp()
 {
-	UnloadTexture(sprite);
-	UnloadSound(soundfx);
-}
-
-void HpPowerUp::setActive(bool active)
-{
-	if (this->active && !active)
-	{
-		PlaySound(soundfx);
-		this->timer = maxTimer;
-	}
-
-	this->active = active;
-}
-
-bool HpPowerUp::getActive()
-{
-	return active;
-}
-
-float HpPowerUp::getRadius()
-{
-	return radius;
+	AssetCache::instance().unloadSprite(sprite);
 }
 
-void HpPowerUp::setSpeedByAngle(float angle)
+void HpPowerUp::setState(const PowerUpState& state)
 {
-	this->speed = Vector2{ (float)cos(angle * DEG2RAD) * maxSpeed, (float)sin(angle * DEG2RAD) * maxSpeed };
+	this->position = state.position;
+	this->rotation = state.rotation;
+	this->radius = state.radius;
+	this->active = state.active;
 }
 
-void HpPowerUp::update()
+void HpPowerUp::collect()
 {
-	screenLimitLogic();
-	movement();
-	updateTimer();
+	VoicePool::instance().play(sample);
 }
 
 void HpPowerUp::draw()
 {
 	if (active)
 	{
-		DrawTexturePro(
+		RenderQueue::instance().submit(
 			sprite,
-			Rectangle{ 0,0,(float)sprite.width,(float)sprite.height },
-			Rectangle{ position.x, position.y, radius * 3, radius * 3 },
-			Vector2{ (radius * 3) / 2, (radius * 3) / 2 },
+			position,
+			Vector2{ radius * 3, radius * 3 },
 			rotation,
-			GREEN);
+			GREEN,
+			RenderLayer::PowerUp);
 #if _DEBUG
-		DrawCircleV(position, radius, Fade(GREEN, 0.5f));
+		RenderBackend::current().drawCircle(position, radius, Fade(GREEN, 0.5f));
 #endif // _DEBUG
 	}
 }
@@ -1,32 +1,24 @@
 #pragma once
 #include "Class/Entity.h"
+#include "Core/AssetCache.h"
+#include "Simulation/SimTypes.h"
 
+/// <summary>
+/// Vista del power up de escudo, el estado y la logica viven en la Simulation
+/// </summary>
 class HpPowerUp : public Entity
 {
 private:
-	const float maxTimer = 5;
-	Texture2D sprite;
-	Sound soundfx;
-	Vector2 speed;
-	float maxSpeed;
-	float rotation;
-	float radius;
+	Sprite sprite;
+	int sample;
+	float rotation = 0.0f;
+	float radius = 0.0f;
 	bool active = false;
-	float timer = maxTimer;
-
-private:
-	void screenLimitLogic();
-	void movement();
-	void updateTimer();
 
 public:
-	HpPowerUp(Vector2 position, const char spriteUrl[], const char soundfxUrl[], Vector2 speed, float maxSpeed, float rotation, float radius, bool active);
+	HpPowerUp(const char spriteUrl[], const char soundfxUrl[]);
 	~HpPowerUp();
-	void setActive(bool active);
-	bool getActive();
-	float getRadius();
-	void setSpeedByAngle(float angle);
-	void update();
+	void setState(const PowerUpState& state);
+	void collect();
 	void draw() override;
 };
-
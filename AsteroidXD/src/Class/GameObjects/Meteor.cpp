@@ -1,95 +1,41 @@
 #include "Meteor.h"
+#include "Core/AssetCache.h"
+#include "Core/RenderBackend.h"
+#include "Core/RenderQueue.h"
+#include "Core/VoicePool.h"
 
-Meteor::Meteor(Vector2 position, const char spriteUrl[], const char explodeSfxUrl[], Vector2 speed, float maxSpeed, float rotation, float radius, bool active) : Entity{ position }
+Meteor::Meteor(const char spriteUrl[], const char explodeSfxUrl[]) : Entity{ Vector2{ 0, 0 } }
 {
-	this->sprite = LoadTexture(spriteUrl);
-	this->explodeSfx = LoadSound(explodeSfxUrl);
-	this->speed = speed;
-	this->maxSpeed = maxSpeed;
-	this->rotation = rotation;
-	this->radius = radius;
-	this->active = active;
+	this->sprite = AssetCache::instance().loadSprite(spriteUrl);
+	this->explodeSample = VoicePool::instance().addSample(explodeSfxUrl);
 }
 
 Meteor::~Meteor()
 {
-	UnloadTexture(sprite);
-	UnloadSound(explodeSfx);
-}
-
-void Meteor::movement()
-{
-	if (active)
-	{
-		// Movement
-		position.x += speed.x * GetFrameTime();
-		position.y += speed.y * GetFrameTime();
-	}
-}
-
-void Meteor::screenLimitsLogic()
-{
-	if (active)
-	{
-		// Collision logic: meteor vs wall
-		if (position.x > GetScreenWidth() + radius) position.x = -radius;
-		else if (position.x < 0 - radius) position.x = GetScreenWidth() + radius;
-		if (position.y > GetScreenHeight() + radius) position.y = -radius;
-		else if (position.y < 0 - radius) position.y = GetScreenHeight() + radius;
-	}
-}
-
-float Meteor::getRadius()
-{
-	return radius;
-}
-
-bool Meteor::getActive()
-{
-	return active;
-}
-
-void Meteor::setActive(bool active)
-{
-	this->active = active;
-}
-
-void Meteor::explode()
-{
-	setActive(false);
-	SetSoundPitch(explodeSfx, ((float)GetRandomValue(0, 45) / 100) + 1);
-	PlaySound(explodeSfx);
+	AssetCache::instance().unloadSprite(sprite);
 }
 
-void Meteor::setSpeed(Vector2 speed)
+void Meteor::setState(Vector2 position, float rotation, float radius)
 {
-	this->speed = speed;
+	this->position = position;
+	this->rotation = rotation;
+	this->radius = radius;
 }
 
-void Meteor::setSpeedByAngle(float angle, bool inverseDir)
+void Meteor::explode(float pitch)
 {
-	this->speed = Vector2{ (float)cos(angle * DEG2RAD) * maxSpeed * ((inverseDir) ? -1.0f : 1.0f), (float)sin(angle * DEG2RAD) * maxSpeed * ((inverseDir) ? -1.0f : 1.0f) };
+	VoicePool::instance().play(explodeSample, pitch);
 }
 
-void Meteor::update()
+void Meteor::submit(Vector2 position, float rotation, float radius) const
 {
-	movement();
-	screenLimitsLogic();
+	RenderQueue::instance().submit(sprite, position, Vector2{ radius * 3, radius * 3 }, rotation, WHITE, RenderLayer::Meteors);
+#if _DEBUG
+	RenderBackend::current().drawCircle(position, radius, Fade(RED, 0.5f));
+#endif // _DEBUG
 }
 
 void Meteor::draw()
 {
-	if (active)
-	{
-		DrawTexturePro(
-			sprite,
-			Rectangle{ 0,0,(float)sprite.width,(float)sprite.height },
-			Rectangle{ position.x, position.y, radius * 3, radius * 3 },
-			Vector2{ (radius * 3) / 2, (radius * 3) / 2 },
-			rotation,
-			WHITE);
-#if _DEBUG
-		DrawCircleV(position, radius, Fade(RED, 0.5f));
-#endif // _DEBUG
-	}
+	submit(position, rotation, radius);
 }
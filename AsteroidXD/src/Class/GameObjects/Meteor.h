@@ -1,31 +1,30 @@
 #pragma once
 #include "Class/Entity.h"
+#include "Core/AssetCache.h"
 
+/// <summary>
+/// Vista de un meteoro, una sola instancia dibuja todo el MeteorField de la Simulation
+/// </summary>
 class Meteor : public Entity
 {
 private:
-	Texture2D sprite;
-	Sound explodeSfx;
-	Vector2 speed;
-	float maxSpeed;
-	float rotation;
-	float radius;
-	bool active;
-
-private:
-	void movement();
-	void screenLimitsLogic();
+	Sprite sprite;
+	int explodeSample;
+	float rotation = 0.0f;
+	float radius = 0.0f;
 
 public:
-	Meteor(Vector2 position, const char spriteUrl[], const char explodeSfxUrl[], Vector2 speed, float maxSpeed, float rotation, float radius, bool active);
+	Meteor(const char spriteUrl[], const char explodeSfxUrl[]);
 	~Meteor();
-	float getRadius();
-	bool getActive();
-	void setActive(bool active);
-	void explode();
-	void setSpeed(Vector2 speed);
-	void setSpeedByAngle(float angle, bool inverseDir = false);
-	void update();
+	void setState(Vector2 position, float rotation, float radius);
+	void explode(float pitch);
+
+	/// <summary>
+	/// Encola un meteoro del campo sin pasar por setState ni draw, para el loop de DrawGame
+	/// </summary>
+	/// <param name="position"></param>
+	/// <param name="rotation"></param>
+	/// <param name="radius"></param>
+	void submit(Vector2 position, float rotation, float radius) const;
 	void draw() override;
 };
-
@@ -1,45 +1,36 @@
 #pragma once
 #include "Class/Entity.h"
+#include "Core/AssetCache.h"
+#include "Simulation/SimTypes.h"
 
+/// <summary>
+/// Vista de la nave, el estado y la logica viven en la Simulation
+/// </summary>
 class Ship : public Entity
 {
 private:
-    const int maxShield = 100;
-    const float defaultRadius = 18.0;
-    const float maxVelocity = 3;
-
-    Texture2D sprite;
+    Sprite sprite;
     Sound engineSfx;
-    Sound shieldSfx;
-    Sound explodeSfx;
-    Color color = WHITE;
+    int shieldSample;
+    int explodeSample;
+    Color tint;
+    Color color;
     Vector2 velocity{ 0,0 };
     Vector2 dir{ 0,0 };
-    Vector2 speed{ 0,0 };
-    float maxAcceleration = 150.0f;
-    int shield = maxShield;
-    float acceleration = 0.0f;
     float rotation = 0.0f;
-    float radius = defaultRadius;
+    float radius = 0.0f;
     float timer = 0.0f;
 
-private:
-    void lookAtMousePoint();
-    void moveForward();
-    void screenLimitsLogic();
-
 public:
-    Ship(Vector2 position, const char spriteUrl[], const char engineUrl[], const char shieldSfxUrl[], const char explodeSfxUrl[]);
+    Ship(Vector2 position, const char spriteUrl[], const char engineUrl[], const char shieldSfxUrl[], const char explodeSfxUrl[], Color tint = WHITE);
     ~Ship();
-    float getRotation();
-    float getRadius();
-    int getShield();
-    int getMaxShield();
-    void resetShield();
-    void resetState();
-    float getMaxSpeed();
-    bool damageShip(Vector2 hitPos = { 0,0 });
-    void update();
+
+    /// <summary>
+    /// Copia el estado de la simulacion y actualiza el sonido del motor
+    /// </summary>
+    /// <param name="state"></param>
+    void sync(const ShipState& state);
+    void onDamaged(float pitch);
+    void onDestroyed();
     void draw() override;
 };
-
@@ -1,30 +1,19 @@
 #pragma once
 #include "Class/Entity.h"
+#include "Simulation/SimTypes.h"
+
+/// <summary>
+/// Vista de un disparo, una sola instancia dibuja todos los estados de la Simulation
+/// </summary>
 class Shoot : public Entity
 {
 private:
-	Vector2 speed;
-	float radius;
-	float rotation;
-	int lifeSpawn;
-	bool active;
+	float radius = 0.0f;
+	bool active = false;
 	Color color;
 
-private:
-	void move();
-	void screenLimitsLogic();
-	void updateLifeSpawn();
-
 public:
-	Shoot(Vector2 position, Vector2 speed, float radius, float rotation, int lifeSpawn, bool active, Color color);
-	bool getActive();
-	float getRadius();
-	float getRotation();
-	void setActive(bool active);
-	void setSpeed(float rotation, float speed);
-	void addLifeSpawn();
-	void resetLifeSpawn();
-	void update();
+	Shoot(Color color);
+	void setState(const ShootState& state);
 	void draw() override;
 };
-
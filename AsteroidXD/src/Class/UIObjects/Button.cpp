@@ -1,4 +1,6 @@
 #include "Button.h"
+#include "Core/AssetCache.h"
+#include "Core/RenderBackend.h"
 
 void Button::mouseCollision()
 {
@@ -10,7 +12,7 @@ void Button::mouseCollision()
 Button::Button(Vector2 position, std::string text, const char clickSfxUrl[], int fontSize, float hMargin, float vMargin, float roundness, int segment, int tickness, Color textColor, Color normalColor, Color pressColor) :
     Entity{position},
     text(text),
-    clickSfx(LoadSound(clickSfxUrl)),
+    clickSfx(AssetCache::instance().loadSound(clickSfxUrl)),
     fontSize(fontSize),
     hMargin(hMargin),
     vMargin(vMargin),
@@ -21,6 +23,11 @@ Button::Button(Vector2 position, std::string text, const char clickSfxUrl[], int
     normalColor(normalColor),
     pressColor(pressColor) { }
 
+Button::~Button()
+{
+    AssetCache::instance().unloadSound(clickSfx);
+}
+
 void Button::setPivot(Vector2 pivot)
 {
     this->pivot = pivot;
@@ -44,25 +51,27 @@ void Button::update()
 
 void Button::draw()
 {
+    RenderBackend& backend = RenderBackend::current();
+    const int textWidth = backend.measureText(text.c_str(), fontSize);
 
-    float deltaX = position.x - (hMargin * 2 + MeasureText(text.c_str(), fontSize)) * pivot.x;
+    float deltaX = position.x - (hMargin * 2 + textWidth) * pivot.x;
     float deltaY = position.y - (vMargin * 2 + fontSize) * pivot.y;
 
     rect = Rectangle
     {
         deltaX,
         deltaY,
-        hMargin * 2 + MeasureText(text.c_str(), fontSize),
+        hMargin * 2 + textWidth,
         vMargin * 2 + fontSize
     };
 
-    DrawRectangleRoundedLines(rect, roundness, segment, tickness, press ? normalColor : pressColor);
-    DrawRectangleRounded(rect, roundness, segment, press ? pressColor : normalColor);
-    DrawText(text.c_str(), rect.x + hMargin, rect.y + vMargin, fontSize, textColor);
+    backend.drawRectangleRoundedLines(rect, roundness, segment, tickness, press ? normalColor : pressColor);
+    backend.drawRectangleRounded(rect, roundness, segment, press ? pressColor : normalColor);
+    backend.drawText(text.c_str(), rect.x + hMargin, rect.y + vMargin, fontSize, textColor);
 
 #if _DEBUG
-    DrawLine(position.x, 0, position.x, GetScreenHeight(), WHITE);
-    DrawLine(0, position.y, GetScreenWidth(), position.y, WHITE);
-    DrawCircle(position.x, position.y, 5.0f, WHITE);
+    backend.drawLine(Vector2{ position.x, 0 }, Vector2{ position.x, (float)GetScreenHeight() }, WHITE);
+    backend.drawLine(Vector2{ 0, position.y }, Vector2{ (float)GetScreenWidth(), position.y }, WHITE);
+    backend.drawCircle(position, 5.0f, WHITE);
 #endif
 }
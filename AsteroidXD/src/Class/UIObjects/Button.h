@@ -40,6 +40,7 @@ public:
 		Color normalColor = BLUE,
 		Color pressColor = DARKBLUE
 	);
+	~Button();
 
 	void setPivot(Vector2 pivot);
 	void setText(std::string text);
@@ -1,4 +1,5 @@
 #include "ProgressBar.h"
+#include "Core/RenderBackend.h"
 
 ProgressBar::ProgressBar(Vector2 position, float width, float height, float roundness, int segment, int lineTick, Color front, Color back):
 	Entity{ position }, width(width), height(height), roundness(roundness), segment(segment), lineTick(lineTick), front(front), back(back) { }
@@ -15,7 +16,9 @@ void ProgressBar::setProgressValue(float value)
 
 void ProgressBar::draw()
 {
+	RenderBackend& backend = RenderBackend::current();
+
 	// Shield Bar
-	DrawRectangleRoundedLines(Rectangle{ position.x - (width * pivot.x),position.y - (height * pivot.y), width, height }, roundness, segment, lineTick, back);
-	DrawRectangleRounded(Rectangle{ position.x - (width * pivot.x), position.y - (height * pivot.y), value * width, height }, roundness, segment, front);
+	backend.drawRectangleRoundedLines(Rectangle{ position.x - (width * pivot.x),position.y - (height * pivot.y), width, height }, roundness, segment, lineTick, back);
+	backend.drawRectangleRounded(Rectangle{ position.x - (width * pivot.x), position.y - (height * pivot.y), value * width, height }, roundness, segment, front);
 }
@@ -0,0 +1,141 @@
+#include "AssetArchive.h"
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetArchive::~AssetArchive()
+{
+    close();
+}
+
+bool AssetArchive::open(const char fileName[])
+{
+    close();
+
+    // The view keeps the mapping alive, the handles can be closed right away
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) return false;
+
+    base = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (base == nullptr) return false;
+
+    size = (size_t)fileSize.QuadPart;
+#else
+    int file = ::open(fileName, O_RDONLY);
+    if (file < 0) return false;
+
+    struct stat fileStat;
+
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        ::close(file);
+        return false;
+    }
+
+    void* view = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (view == MAP_FAILED) return false;
+
+    base = (const unsigned char*)view;
+    size = (size_t)fileStat.st_size;
+#endif
+
+    if (!validate())
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool AssetArchive::validate()
+{
+    if (size < sizeof(ArchiveHeader)) return false;
+
+    ArchiveHeader header;
+    memcpy(&header, base, sizeof(header));
+
+    if (memcmp(header.magic, archiveMagic, sizeof(archiveMagic)) != 0 || header.version != archiveVersion) return false;
+
+    const uint64_t namesStart = sizeof(ArchiveHeader) + (uint64_t)header.entryCount * sizeof(ArchiveEntry);
+    if (namesStart + header.namesSize > size) return false;
+
+    entries = (const ArchiveEntry*)(base + sizeof(ArchiveHeader));
+    const char* names = (const char*)(base + namesStart);
+
+    index.reserve(header.entryCount);
+
+    for (uint32_t i = 0; i < header.entryCount; i++)
+    {
+        const ArchiveEntry& entry = entries[i];
+
+        if ((uint64_t)entry.nameOffset + entry.nameLength > header.namesSize) return false;
+        if (entry.offset > size || entry.size > size - entry.offset) return false;
+
+        index.emplace(std::string(names + entry.nameOffset, entry.nameLength), (int)i);
+    }
+
+    return true;
+}
+
+void AssetArchive::close()
+{
+    if (base != nullptr)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(base);
+#else
+        munmap((void*)base, size);
+#endif
+    }
+
+    base = nullptr;
+    size = 0;
+    entries = nullptr;
+    index.clear();
+}
+
+bool AssetArchive::isOpen() const
+{
+    return base != nullptr;
+}
+
+const ArchiveEntry* AssetArchive::find(const char path[]) const
+{
+    auto it = index.find(path);
+    return (it != index.end()) ? &entries[it->second] : nullptr;
+}
+
+const unsigned char* AssetArchive::getData(const ArchiveEntry& entry) const
+{
+    return base + entry.offset;
+}
+
+int AssetArchive::getEntryCount() const
+{
+    return (int)index.size();
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// Archive layout: ArchiveHeader, entryCount ArchiveEntry, the names (not null terminated)
+// and the data of each entry aligned to archiveAlignment from the start of the file
+
+static const char archiveMagic[4] = { 'A', 'X', 'D', 'P' };
+static const uint32_t archiveVersion = 1;
+static const uint64_t archiveAlignment = 16;
+
+enum class ArchiveEntryKind : uint32_t
+{
+    // The file as it is on disk (OGG, PNG...)
+    File = 0,
+
+    // Pixels already decoded by the packer, ready for LoadTextureFromImage
+    Image = 1
+};
+
+struct ArchiveHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t namesSize;
+};
+
+struct ArchiveEntry
+{
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    ArchiveEntryKind kind;
+
+    // Only for ArchiveEntryKind::Image, same meaning as in raylib's Image
+    int32_t width;
+    int32_t height;
+    int32_t format;
+    int32_t mipmaps;
+    uint32_t reserved;
+
+    uint64_t offset;
+    uint64_t size;
+};
+
+static_assert(sizeof(ArchiveHeader) == 16, "ArchiveHeader is written as is");
+static_assert(sizeof(ArchiveEntry) == 48, "ArchiveEntry is written as is");
+
+/// <summary>
+/// Lector de archivos .axdp: mapea el archivo en memoria y entrega punteros a cada entrada por ruta,
+/// sin copiar ni leer nada hasta que se toca. No incluye raylib (windows.h choca con sus nombres).
+/// </summary>
+class AssetArchive
+{
+private:
+    const unsigned char* base = nullptr;
+    size_t size = 0;
+
+    const ArchiveEntry* entries = nullptr;
+    std::unordered_map<std::string, int> index;
+
+private:
+    bool validate();
+
+public:
+    AssetArchive() = default;
+    ~AssetArchive();
+
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    /// <summary>
+    /// Mapea el archivo y valida el indice
+    /// </summary>
+    /// <param name="fileName"></param>
+    /// <returns>false si no existe o esta corrupto, en ese caso queda cerrado</returns>
+    bool open(const char fileName[]);
+    void close();
+    bool isOpen() const;
+
+    /// <summary>
+    /// Busca una entrada por su ruta (la misma que se usa para los archivos sueltos)
+    /// </summary>
+    /// <param name="path"></param>
+    /// <returns>nullptr si no esta en el archivo</returns>
+    const ArchiveEntry* find(const char path[]) const;
+
+    const unsigned char* getData(const ArchiveEntry& entry) const;
+    int getEntryCount() const;
+};
@@ -0,0 +1,316 @@
+#include "AssetCache.h"
+#include "RenderBackend.h"
+#include "TextureAtlas.h"
+
+AssetCache& AssetCache::instance()
+{
+    static AssetCache cache;
+    return cache;
+}
+
+void AssetCache::addResident(size_t bytes)
+{
+    stats.residentBytes += bytes;
+    if (stats.residentBytes > stats.peakResidentBytes) stats.peakResidentBytes = stats.residentBytes;
+}
+
+Texture2D AssetCache::loadTexture(const char url[])
+{
+    auto it = textures.find(url);
+
+    if (it != textures.end())
+    {
+        stats.hits++;
+        it->second.refCount++;
+        return it->second.texture;
+    }
+
+    stats.misses++;
+
+    // Through the backend so the id belongs to whoever draws it
+    Image image = LoadImage(url);
+    Texture2D texture = RenderBackend::current().loadTexture(image);
+    UnloadImage(image);
+
+    size_t bytes = (size_t)GetPixelDataSize(texture.width, texture.height, texture.format);
+
+    textures.emplace(url, TextureEntry{ texture, 1, bytes });
+    stats.textureCount++;
+    addResident(bytes);
+
+    return texture;
+}
+
+void AssetCache::unloadTexture(Texture2D texture)
+{
+    for (auto it = textures.begin(); it != textures.end(); ++it)
+    {
+        if (it->second.texture.id != texture.id) continue;
+
+        if (--it->second.refCount <= 0)
+        {
+            // An atlas takes its regions with it
+            for (auto sprite = sprites.begin(); sprite != sprites.end();)
+            {
+                if (sprite->second.atlas == it->first) sprite = sprites.erase(sprite);
+                else ++sprite;
+            }
+
+            RenderBackend::current().unloadTexture(it->second.texture);
+            stats.textureCount--;
+            stats.residentBytes -= it->second.bytes;
+            textures.erase(it);
+        }
+
+        return;
+    }
+
+    // Not owned by the cache
+    RenderBackend::current().unloadTexture(texture);
+}
+
+Sprite AssetCache::loadSprite(const char url[])
+{
+    auto region = sprites.find(url);
+
+    if (region != sprites.end())
+    {
+        return Sprite{ loadTexture(region->second.atlas.c_str()), region->second.source };
+    }
+
+    Texture2D texture = loadTexture(url);
+    return Sprite{ texture, Rectangle{ 0, 0, (float)texture.width, (float)texture.height } };
+}
+
+void AssetCache::unloadSprite(Sprite sprite)
+{
+    unloadTexture(sprite.texture);
+}
+
+Sound AssetCache::loadSound(const char url[])
+{
+    auto it = sounds.find(url);
+
+    if (it != sounds.end())
+    {
+        stats.hits++;
+        it->second.refCount++;
+        return it->second.sound;
+    }
+
+    // Headless runs draw without an audio device, the views get a silent sound
+    if (!IsAudioDeviceReady()) return Sound{};
+
+    stats.misses++;
+
+    // A voice reads the same file as the sound it copies
+    const std::string path = url;
+    Sound sound = LoadSound(path.substr(0, path.find('#')).c_str());
+    size_t bytes = (size_t)sound.sampleCount * sound.stream.sampleSize / 8;
+
+    sounds.emplace(url, SoundEntry{ sound, 1, bytes });
+    stats.soundCount++;
+    addResident(bytes);
+
+    return sound;
+}
+
+std::string AssetCache::voiceUrl(const char url[], int voice)
+{
+    if (voice == 0) return url;
+
+    return std::string(url) + "#" + std::to_string(voice);
+}
+
+void AssetCache::unloadSound(Sound sound)
+{
+    if (sound.stream.buffer == nullptr) return;
+
+    for (auto it = sounds.begin(); it != sounds.end(); ++it)
+    {
+        if (it->second.sound.stream.buffer != sound.stream.buffer) continue;
+
+        if (--it->second.refCount <= 0)
+        {
+            UnloadSound(it->second.sound);
+            stats.soundCount--;
+            stats.residentBytes -= it->second.bytes;
+            sounds.erase(it);
+        }
+
+        return;
+    }
+
+    // Not owned by the cache
+    UnloadSound(sound);
+}
+
+Music AssetCache::loadMusic(const char url[])
+{
+    auto it = musics.find(url);
+
+    if (it != musics.end())
+    {
+        stats.hits++;
+        it->second.refCount++;
+        return it->second.music;
+    }
+
+    if (!IsAudioDeviceReady()) return Music{};
+
+    stats.misses++;
+
+    // Streamed from disk, only the decoder state is resident
+    Music music = LoadMusicStream(url);
+
+    musics.emplace(url, MusicEntry{ music, 1, 0, nullptr });
+    stats.musicCount++;
+
+    return music;
+}
+
+void AssetCache::unloadMusic(Music music)
+{
+    if (music.ctxData == nullptr) return;
+
+    for (auto it = musics.begin(); it != musics.end(); ++it)
+    {
+        if (it->second.music.ctxData != music.ctxData) continue;
+
+        if (--it->second.refCount <= 0)
+        {
+            UnloadMusicStream(it->second.music);
+            if (it->second.data != nullptr) UnloadFileData(it->second.data);
+
+            stats.musicCount--;
+            stats.residentBytes -= it->second.bytes;
+            musics.erase(it);
+        }
+
+        return;
+    }
+
+    // Not owned by the cache
+    UnloadMusicStream(music);
+}
+
+Texture2D AssetCache::adoptTexture(const char url[], Image image)
+{
+    auto it = textures.find(url);
+
+    if (it != textures.end())
+    {
+        UnloadImage(image);
+
+        stats.hits++;
+        it->second.refCount++;
+        return it->second.texture;
+    }
+
+    stats.misses++;
+
+    Texture2D texture = RenderBackend::current().loadTexture(image);
+    UnloadImage(image);
+
+    size_t bytes = (size_t)GetPixelDataSize(texture.width, texture.height, texture.format);
+
+    textures.emplace(url, TextureEntry{ texture, 1, bytes });
+    stats.textureCount++;
+    addResident(bytes);
+
+    return texture;
+}
+
+Sound AssetCache::adoptSound(const char url[], Wave wave)
+{
+    auto it = sounds.find(url);
+
+    if (it != sounds.end())
+    {
+        UnloadWave(wave);
+
+        stats.hits++;
+        it->second.refCount++;
+        return it->second.sound;
+    }
+
+    stats.misses++;
+
+    Sound sound = LoadSoundFromWave(wave);
+    UnloadWave(wave);
+
+    size_t bytes = (size_t)sound.sampleCount * sound.stream.sampleSize / 8;
+
+    sounds.emplace(url, SoundEntry{ sound, 1, bytes });
+    stats.soundCount++;
+    addResident(bytes);
+
+    return sound;
+}
+
+Texture2D AssetCache::adoptAtlas(const char url[], TextureAtlas& atlas)
+{
+    Texture2D texture = adoptTexture(url, atlas.build());
+
+    for (const auto& region : atlas.getRegions())
+    {
+        sprites[region.first] = SpriteRegion{ url, region.second };
+    }
+
+    return texture;
+}
+
+Music AssetCache::adoptMusic(const char url[], unsigned char* data, unsigned int size)
+{
+    auto it = musics.find(url);
+
+    if (it != musics.end())
+    {
+        UnloadFileData(data);
+
+        stats.hits++;
+        it->second.refCount++;
+        return it->second.music;
+    }
+
+    stats.misses++;
+
+    Music music = LoadMusicStreamFromMemory(GetFileExtension(url), data, (int)size);
+
+    musics.emplace(url, MusicEntry{ music, 1, size, data });
+    stats.musicCount++;
+    addResident(size);
+
+    return music;
+}
+
+const AssetCacheStats& AssetCache::getStats() const
+{
+    return stats;
+}
+
+int AssetCache::getResidentCount() const
+{
+    return (int)(textures.size() + sounds.size() + musics.size());
+}
+
+void AssetCache::logResident(int logLevel, const char title[]) const
+{
+    TraceLog(logLevel, "ASSETS: %s, %i resident, %i KB (peak %i KB)", title, getResidentCount(),
+        (int)(stats.residentBytes / 1024), (int)(stats.peakResidentBytes / 1024));
+
+    for (const auto& entry : textures)
+    {
+        TraceLog(logLevel, "ASSETS:     texture %-48s refs %3i %8i KB", entry.first.c_str(), entry.second.refCount, (int)(entry.second.bytes / 1024));
+    }
+
+    for (const auto& entry : sounds)
+    {
+        TraceLog(logLevel, "ASSETS:     sound   %-48s refs %3i %8i KB", entry.first.c_str(), entry.second.refCount, (int)(entry.second.bytes / 1024));
+    }
+
+    for (const auto& entry : musics)
+    {
+        TraceLog(logLevel, "ASSETS:     music   %-48s refs %3i %8i KB", entry.first.c_str(), entry.second.refCount, (int)(entry.second.bytes / 1024));
+    }
+}
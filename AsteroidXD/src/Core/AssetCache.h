@@ -0,0 +1,173 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include "raylib.h"
+
+class TextureAtlas;
+
+/// <summary>
+/// Contadores del cache, residentBytes es lo que ocupan los assets cargados
+/// </summary>
+struct AssetCacheStats
+{
+    unsigned int hits = 0;
+    unsigned int misses = 0;
+    unsigned int textureCount = 0;
+    unsigned int soundCount = 0;
+    unsigned int musicCount = 0;
+    size_t residentBytes = 0;
+    size_t peakResidentBytes = 0;
+};
+
+/// <summary>
+/// Textura y rectangulo de origen de un sprite, la textura puede ser un atlas compartido
+/// </summary>
+struct Sprite
+{
+    Texture2D texture;
+    Rectangle source;
+};
+
+/// <summary>
+/// Cache de texturas y sonidos por ruta con conteo de referencias.
+/// Cada ruta se decodifica una sola vez y todos los que la piden comparten el mismo handle,
+/// el asset se libera cuando se suelta la ultima referencia.
+/// </summary>
+class AssetCache
+{
+private:
+    struct TextureEntry
+    {
+        Texture2D texture;
+        int refCount;
+        size_t bytes;
+    };
+
+    struct SoundEntry
+    {
+        Sound sound;
+        int refCount;
+        size_t bytes;
+    };
+
+    struct MusicEntry
+    {
+        Music music;
+        int refCount;
+        size_t bytes;
+
+        // Streams opened from memory read from this buffer until they are unloaded
+        unsigned char* data;
+    };
+
+    std::unordered_map<std::string, TextureEntry> textures;
+    std::unordered_map<std::string, SoundEntry> sounds;
+    std::unordered_map<std::string, MusicEntry> musics;
+
+    // Sprite path -> region inside the atlas registered with adoptAtlas
+    struct SpriteRegion
+    {
+        std::string atlas;
+        Rectangle source;
+    };
+
+    std::unordered_map<std::string, SpriteRegion> sprites;
+    AssetCacheStats stats;
+
+private:
+    AssetCache() = default;
+
+    void addResident(size_t bytes);
+
+public:
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    static AssetCache& instance();
+
+    /// <summary>
+    /// Devuelve la textura de la ruta, la carga si nadie la tiene
+    /// </summary>
+    /// <param name="url"></param>
+    /// <returns></returns>
+    Texture2D loadTexture(const char url[]);
+
+    /// <summary>
+    /// Suelta una referencia, la ultima descarga la textura de la GPU
+    /// </summary>
+    /// <param name="texture"></param>
+    void unloadTexture(Texture2D texture);
+
+    /// <summary>
+    /// Devuelve el sprite de la ruta: su region dentro del atlas si esta en uno,
+    /// si no la textura suelta completa. Cuenta como una referencia a la textura
+    /// </summary>
+    /// <param name="url"></param>
+    /// <returns></returns>
+    Sprite loadSprite(const char url[]);
+    void unloadSprite(Sprite sprite);
+
+    /// <summary>
+    /// Devuelve el sonido de la ruta. Las voces de un mismo archivo (ver voiceUrl) son buffers aparte,
+    /// asi pueden sonar a la vez
+    /// </summary>
+    /// <param name="url"></param>
+    /// <returns></returns>
+    Sound loadSound(const char url[]);
+    void unloadSound(Sound sound);
+
+    /// <summary>
+    /// Ruta de la voz n de un sonido: la 0 es la ruta misma, las demas "ruta#n"
+    /// </summary>
+    /// <param name="url"></param>
+    /// <param name="voice"></param>
+    /// <returns></returns>
+    static std::string voiceUrl(const char url[], int voice);
+
+    Music loadMusic(const char url[]);
+    void unloadMusic(Music music);
+
+    /// <summary>
+    /// Sube a la GPU una imagen ya decodificada (por AssetLoader) y la registra con la ruta.
+    /// Se queda con la imagen y devuelve una referencia igual que loadTexture
+    /// </summary>
+    /// <param name="url"></param>
+    /// <param name="image"></param>
+    /// <returns></returns>
+    Texture2D adoptTexture(const char url[], Image image);
+
+    Sound adoptSound(const char url[], Wave wave);
+
+    /// <summary>
+    /// Arma el atlas, lo sube como una textura con la ruta url y registra sus regiones para loadSprite
+    /// </summary>
+    /// <param name="url"></param>
+    /// <param name="atlas"></param>
+    /// <returns>La textura del atlas, con una referencia para quien llama</returns>
+    Texture2D adoptAtlas(const char url[], TextureAtlas& atlas);
+
+    /// <summary>
+    /// Abre el stream sobre el archivo ya leido, el buffer (de LoadFileData) pasa a ser del cache
+    /// </summary>
+    /// <param name="url"></param>
+    /// <param name="data"></param>
+    /// <param name="size"></param>
+    /// <returns></returns>
+    Music adoptMusic(const char url[], unsigned char* data, unsigned int size);
+
+    const AssetCacheStats& getStats() const;
+
+    /// <summary>
+    /// Cantidad de assets cargados (texturas, sonidos y musica)
+    /// </summary>
+    /// <returns></returns>
+    int getResidentCount() const;
+
+    /// <summary>
+    /// Escribe en el log cada asset cargado con sus referencias y bytes, y el total.
+    /// Al cerrar, despues de soltar todos los scopes, lo que aparece es una fuga
+    /// </summary>
+    /// <param name="logLevel"></param>
+    /// <param name="title"></param>
+    void logResident(int logLevel, const char title[]) const;
+};
@@ -0,0 +1,260 @@
+#include "AssetLoader.h"
+#include <cstring>
+#include "AssetArchive.h"
+#include "AssetCache.h"
+
+static const char spriteAtlasUrl[] = "atlas/sprites";
+
+AssetLoader::~AssetLoader()
+{
+    for (std::thread& thread : threads) thread.join();
+
+    // Decoded but never uploaded
+    for (DecodedAsset& asset : decoded)
+    {
+        if (asset.image.data != nullptr) UnloadImage(asset.image);
+        if (asset.wave.data != nullptr) UnloadWave(asset.wave);
+        if (asset.data != nullptr) UnloadFileData(asset.data);
+    }
+}
+
+void AssetLoader::queue(AssetKind kind, const char url[], int voices)
+{
+    if (!threads.empty()) return;
+
+    for (AssetRequest& request : requests)
+    {
+        if (request.url != url) continue;
+
+        if (voices > request.voices) request.voices = voices;
+        return;
+    }
+
+    requests.push_back(AssetRequest{ kind, url, voices });
+}
+
+void AssetLoader::setArchive(const AssetArchive* archive)
+{
+    if (threads.empty()) this->archive = archive;
+}
+
+void AssetLoader::queueTexture(const char url[])
+{
+    queue(AssetKind::Texture, url);
+}
+
+void AssetLoader::queueSprite(const char url[])
+{
+    queue(AssetKind::Sprite, url);
+}
+
+void AssetLoader::queueSound(const char url[], int voices)
+{
+    queue(AssetKind::Sound, url, voices);
+}
+
+void AssetLoader::queueMusic(const char url[])
+{
+    queue(AssetKind::Music, url);
+}
+
+void AssetLoader::start(int threadCount)
+{
+    if (!threads.empty()) return;
+
+    if (threadCount > (int)requests.size()) threadCount = (int)requests.size();
+
+    // Dedicated threads instead of the JobSystem: a decode takes milliseconds and would stall
+    // whichever simulation tick helped run it
+    for (int i = 0; i < threadCount; i++)
+    {
+        threads.emplace_back(&AssetLoader::decodeLoop, this);
+    }
+}
+
+void AssetLoader::decodeLoop()
+{
+    const int count = (int)requests.size();
+
+    for (int i = nextRequest++; i < count; i = nextRequest++)
+    {
+        const AssetRequest& request = requests[i];
+        const ArchiveEntry* entry = (archive != nullptr) ? archive->find(request.url.c_str()) : nullptr;
+
+        DecodedAsset asset = {};
+        asset.request = i;
+
+        if (entry != nullptr) decodePacked(request, *entry, asset);
+        else decodeFile(request, asset);
+
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        decoded.push_back(asset);
+    }
+}
+
+void AssetLoader::decodeFile(const AssetRequest& request, DecodedAsset& asset)
+{
+    asset.data = LoadFileData(request.url.c_str(), &asset.size);
+    if (asset.data == nullptr) return;
+
+    const char* fileType = GetFileExtension(request.url.c_str());
+
+    switch (request.kind)
+    {
+    case AssetKind::Texture:
+    case AssetKind::Sprite:
+        asset.image = LoadImageFromMemory(fileType, asset.data, (int)asset.size);
+        UnloadFileData(asset.data);
+        asset.data = nullptr;
+        break;
+
+    case AssetKind::Sound:
+        asset.wave = LoadWaveFromMemory(fileType, asset.data, (int)asset.size);
+        UnloadFileData(asset.data);
+        asset.data = nullptr;
+        break;
+
+    case AssetKind::Music:
+        // The stream decodes while it plays, keep the file bytes
+        break;
+    }
+}
+
+void AssetLoader::decodePacked(const AssetRequest& request, const ArchiveEntry& entry, DecodedAsset& asset)
+{
+    const unsigned char* bytes = archive->getData(entry);
+    const char* fileType = GetFileExtension(request.url.c_str());
+
+    switch (request.kind)
+    {
+    case AssetKind::Texture:
+    case AssetKind::Sprite:
+        if (entry.kind == ArchiveEntryKind::Image)
+        {
+            // Already decoded by the packer, only a copy the cache can own
+            asset.image.data = MemAlloc((int)entry.size);
+            memcpy(asset.image.data, bytes, (size_t)entry.size);
+            asset.image.width = entry.width;
+            asset.image.height = entry.height;
+            asset.image.format = entry.format;
+            asset.image.mipmaps = entry.mipmaps;
+        }
+        else asset.image = LoadImageFromMemory(fileType, bytes, (int)entry.size);
+        break;
+
+    case AssetKind::Sound:
+        asset.wave = LoadWaveFromMemory(fileType, bytes, (int)entry.size);
+        break;
+
+    case AssetKind::Music:
+        // The cache frees the stream buffer with UnloadFileData, it can not point into the mapping
+        asset.size = (unsigned int)entry.size;
+        asset.data = (unsigned char*)MemAlloc((int)entry.size);
+        memcpy(asset.data, bytes, (size_t)entry.size);
+        break;
+    }
+}
+
+void AssetLoader::upload(DecodedAsset& asset)
+{
+    const AssetRequest& request = requests[asset.request];
+    const char* url = request.url.c_str();
+
+    switch (request.kind)
+    {
+    case AssetKind::Texture:
+        if (asset.image.data == nullptr) break;
+
+        assets.track(AssetCache::instance().adoptTexture(url, asset.image));
+        return;
+
+    case AssetKind::Sprite:
+        if (asset.image.data == nullptr) break;
+
+        atlas.add(url, asset.image);
+        return;
+
+    case AssetKind::Sound:
+        if (asset.wave.data == nullptr) break;
+
+        // Every extra voice gets its own copy, the sound itself keeps the decoded wave
+        for (int voice = 1; voice < request.voices; voice++)
+        {
+            assets.track(AssetCache::instance().adoptSound(AssetCache::voiceUrl(url, voice).c_str(), WaveCopy(asset.wave)));
+        }
+
+        assets.track(AssetCache::instance().adoptSound(url, asset.wave));
+        return;
+
+    case AssetKind::Music:
+        if (asset.data == nullptr) break;
+
+        assets.track(AssetCache::instance().adoptMusic(url, asset.data, asset.size));
+        return;
+    }
+
+    // Whoever asks for it later falls back to the synchronous load of the cache
+    TraceLog(LOG_WARNING, "LOADER: Could not decode %s", url);
+    failed++;
+}
+
+int AssetLoader::finalize(double budgetSeconds)
+{
+    const double start = GetTime();
+    int uploaded = 0;
+
+    while (finished < (int)requests.size())
+    {
+        DecodedAsset asset;
+
+        {
+            std::lock_guard<std::mutex> lock(decodedMutex);
+            if (decoded.empty()) break;
+
+            asset = decoded.back();
+            decoded.pop_back();
+        }
+
+        upload(asset);
+        finished++;
+        uploaded++;
+
+        if (GetTime() - start >= budgetSeconds) break;
+    }
+
+    if (isDone() && atlas.getPendingCount() > 0)
+    {
+        assets.track(AssetCache::instance().adoptAtlas(spriteAtlasUrl, atlas));
+    }
+
+    if (isDone() && !threads.empty())
+    {
+        for (std::thread& thread : threads) thread.join();
+        threads.clear();
+
+        // Every thread claimed one index past the end before leaving
+        nextRequest = (int)requests.size();
+    }
+
+    return uploaded;
+}
+
+float AssetLoader::getProgress() const
+{
+    return requests.empty() ? 1.0f : (float)finished / (float)requests.size();
+}
+
+bool AssetLoader::isDone() const
+{
+    return finished >= (int)requests.size();
+}
+
+int AssetLoader::getFailedCount() const
+{
+    return failed;
+}
+
+void AssetLoader::release()
+{
+    assets.release();
+}
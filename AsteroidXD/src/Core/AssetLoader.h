@@ -0,0 +1,130 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "raylib.h"
+#include "AssetScope.h"
+#include "TextureAtlas.h"
+
+class AssetArchive;
+struct ArchiveEntry;
+
+/// <summary>
+/// Carga en segundo plano: los hilos del loader leen y decodifican los PNG/OGG,
+/// el hilo principal solo sube a la GPU (o al dispositivo de audio) lo que ya esta listo.
+/// Los assets terminados quedan en AssetCache con una referencia del loader,
+/// asi los que despues los pidan por ruta no esperan nada.
+/// Con un AssetArchive abierto las rutas que esten empaquetadas se leen del archivo mapeado.
+/// </summary>
+class AssetLoader
+{
+private:
+    enum class AssetKind
+    {
+        Texture,
+        Sprite,
+        Sound,
+        Music
+    };
+
+    struct AssetRequest
+    {
+        AssetKind kind;
+        std::string url;
+
+        // Sounds only, separate buffers of the same wave for VoicePool
+        int voices;
+    };
+
+    struct DecodedAsset
+    {
+        int request;
+        Image image;
+        Wave wave;
+        unsigned char* data;
+        unsigned int size;
+    };
+
+    std::vector<AssetRequest> requests;
+    const AssetArchive* archive = nullptr;
+
+    // Filled by the loader threads, emptied by finalize()
+    std::mutex decodedMutex;
+    std::vector<DecodedAsset> decoded;
+
+    std::vector<std::thread> threads;
+    std::atomic<int> nextRequest{ 0 };
+    int finished = 0;
+    int failed = 0;
+
+    // Sprites wait here until every request is decoded, then go up as one texture
+    TextureAtlas atlas;
+
+    // References held until release()
+    AssetScope assets{ "loader" };
+
+private:
+    void queue(AssetKind kind, const char url[], int voices = 1);
+    void decodeLoop();
+    void decodeFile(const AssetRequest& request, DecodedAsset& asset);
+    void decodePacked(const AssetRequest& request, const ArchiveEntry& entry, DecodedAsset& asset);
+    void upload(DecodedAsset& asset);
+
+public:
+    AssetLoader() = default;
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    /// <summary>
+    /// Archivo empaquetado del que leer, tiene que seguir abierto mientras el loader trabaja
+    /// </summary>
+    /// <param name="archive"></param>
+    void setArchive(const AssetArchive* archive);
+
+    void queueTexture(const char url[]);
+
+    /// <summary>
+    /// Como queueTexture, pero la imagen termina en el atlas de sprites (ver AssetCache::loadSprite)
+    /// </summary>
+    /// <param name="url"></param>
+    void queueSprite(const char url[]);
+
+    /// <summary>
+    /// Encola un sonido, con voices mayor a 1 tambien sube las voces extra (AssetCache::voiceUrl) del mismo wave
+    /// </summary>
+    /// <param name="url"></param>
+    /// <param name="voices"></param>
+    void queueSound(const char url[], int voices = 1);
+    void queueMusic(const char url[]);
+
+    /// <summary>
+    /// Arranca los hilos que decodifican lo encolado, no se puede encolar mas hasta que termine
+    /// </summary>
+    /// <param name="threadCount"></param>
+    void start(int threadCount = 2);
+
+    /// <summary>
+    /// Hilo principal: sube los assets decodificados hasta gastar budgetSeconds (siempre sube al menos uno)
+    /// </summary>
+    /// <param name="budgetSeconds"></param>
+    /// <returns>Cuantos assets termino en esta llamada</returns>
+    int finalize(double budgetSeconds);
+
+    /// <summary>
+    /// Fraccion de assets terminados, de 0 a 1
+    /// </summary>
+    /// <returns></returns>
+    float getProgress() const;
+
+    bool isDone() const;
+    int getFailedCount() const;
+
+    /// <summary>
+    /// Suelta las referencias del loader, los assets siguen vivos mientras otro scope los use
+    /// </summary>
+    void release();
+};
@@ -0,0 +1,170 @@
+#include "AssetPacker.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "raylib.h"
+#include "AssetArchive.h"
+
+static const char* packedFolders[] = { "resources/images", "resources/music", "resources/sfx" };
+static const char packedExtensions[] = ".png;.ogg;.wav;.mp3";
+
+struct PackedFile
+{
+    std::string path;
+    ArchiveEntry entry;
+
+    // Owned by raylib, freed after writing
+    Image image;
+    unsigned char* data;
+};
+
+static uint64_t Align(uint64_t offset)
+{
+    return (offset + archiveAlignment - 1) / archiveAlignment * archiveAlignment;
+}
+
+static void Pad(std::ofstream& file, uint64_t from, uint64_t to)
+{
+    static const char zeros[archiveAlignment] = {};
+    file.write(zeros, (std::streamsize)(to - from));
+}
+
+static bool CollectFiles(std::vector<PackedFile>& files)
+{
+    for (const char* folder : packedFolders)
+    {
+        if (!DirectoryExists(folder))
+        {
+            printf("%s not found, run the packer next to resources/\n", folder);
+            return false;
+        }
+
+        int count = 0;
+        char** names = GetDirectoryFiles(folder, &count);
+
+        for (int i = 0; i < count; i++)
+        {
+            if (!IsFileExtension(names[i], packedExtensions)) continue;
+
+            PackedFile file = {};
+            file.path = std::string(folder) + "/" + names[i];
+            files.push_back(file);
+        }
+
+        ClearDirectoryFiles();
+    }
+
+    return true;
+}
+
+static bool LoadPackedFile(PackedFile& file)
+{
+    ArchiveEntry& entry = file.entry;
+    entry.mipmaps = 1;
+
+    if (IsFileExtension(file.path.c_str(), ".png"))
+    {
+        file.image = LoadImage(file.path.c_str());
+        if (file.image.data == nullptr) return false;
+
+        entry.kind = ArchiveEntryKind::Image;
+        entry.width = file.image.width;
+        entry.height = file.image.height;
+        entry.format = file.image.format;
+        entry.mipmaps = file.image.mipmaps;
+        entry.size = (uint64_t)GetPixelDataSize(file.image.width, file.image.height, file.image.format);
+        return true;
+    }
+
+    unsigned int bytesRead = 0;
+    file.data = LoadFileData(file.path.c_str(), &bytesRead);
+    if (file.data == nullptr) return false;
+
+    entry.kind = ArchiveEntryKind::File;
+    entry.size = bytesRead;
+    return true;
+}
+
+int PackResources(const char output[])
+{
+    std::vector<PackedFile> files;
+    if (!CollectFiles(files)) return 1;
+
+    int exitCode = 0;
+    uint32_t namesSize = 0;
+
+    for (PackedFile& file : files)
+    {
+        if (!LoadPackedFile(file))
+        {
+            printf("%s could not be read\n", file.path.c_str());
+            exitCode = 1;
+        }
+
+        file.entry.nameOffset = namesSize;
+        file.entry.nameLength = (uint32_t)file.path.size();
+        namesSize += file.entry.nameLength;
+    }
+
+    // Layout: every entry starts aligned after the header, the index and the names
+    uint64_t offset = Align(sizeof(ArchiveHeader) + files.size() * sizeof(ArchiveEntry) + namesSize);
+
+    for (PackedFile& file : files)
+    {
+        file.entry.offset = offset;
+        offset = Align(offset + file.entry.size);
+    }
+
+    ArchiveHeader header = {};
+    memcpy(header.magic, archiveMagic, sizeof(archiveMagic));
+    header.version = archiveVersion;
+    header.entryCount = (uint32_t)files.size();
+    header.namesSize = namesSize;
+
+    std::ofstream archive(output, std::ios::binary);
+
+    if (exitCode == 0 && archive)
+    {
+        archive.write((const char*)&header, sizeof(header));
+
+        for (const PackedFile& file : files) archive.write((const char*)&file.entry, sizeof(ArchiveEntry));
+        for (const PackedFile& file : files) archive.write(file.path.data(), (std::streamsize)file.path.size());
+
+        uint64_t written = sizeof(ArchiveHeader) + files.size() * sizeof(ArchiveEntry) + namesSize;
+
+        for (const PackedFile& file : files)
+        {
+            Pad(archive, written, file.entry.offset);
+
+            const void* bytes = (file.entry.kind == ArchiveEntryKind::Image) ? file.image.data : (const void*)file.data;
+            archive.write((const char*)bytes, (std::streamsize)file.entry.size);
+
+            written = file.entry.offset + file.entry.size;
+        }
+
+        Pad(archive, written, offset);
+
+        if (!archive)
+        {
+            printf("%s could not be written\n", output);
+            exitCode = 1;
+        }
+    }
+    else if (exitCode == 0)
+    {
+        printf("%s could not be created\n", output);
+        exitCode = 1;
+    }
+
+    for (PackedFile& file : files)
+    {
+        if (file.image.data != nullptr) UnloadImage(file.image);
+        if (file.data != nullptr) UnloadFileData(file.data);
+    }
+
+    if (exitCode == 0) printf("%s: %i files, %llu KB\n", output, (int)files.size(), (unsigned long long)(offset / 1024));
+
+    return exitCode;
+}
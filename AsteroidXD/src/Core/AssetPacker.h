@@ -0,0 +1,14 @@
+#pragma once
+
+#pragma region FUNCTIONS
+
+/// <summary>
+/// Empaqueta resources/images, resources/music y resources/sfx en un solo archivo .axdp.
+/// Los PNG se guardan ya decodificados (pixeles listos para la GPU), el audio tal cual.
+/// Se corre al compilar, desde la carpeta donde esta resources
+/// </summary>
+/// <param name="output"></param>
+/// <returns>Codigo de salida del proceso, distinto de 0 si algun archivo no se pudo leer o escribir</returns>
+int PackResources(const char output[]);
+
+#pragma endregion
@@ -0,0 +1,82 @@
+#include "AssetScope.h"
+#include "AssetCache.h"
+
+AssetScope::AssetScope(const char name[]) : name(name) { }
+
+AssetScope::~AssetScope()
+{
+    release();
+}
+
+Texture2D AssetScope::loadTexture(const char url[])
+{
+    Texture2D texture = AssetCache::instance().loadTexture(url);
+    textures.push_back(texture);
+    return texture;
+}
+
+Sprite AssetScope::loadSprite(const char url[])
+{
+    Sprite sprite = AssetCache::instance().loadSprite(url);
+    textures.push_back(sprite.texture);
+    return sprite;
+}
+
+Sound AssetScope::loadSound(const char url[])
+{
+    Sound sound = AssetCache::instance().loadSound(url);
+    sounds.push_back(sound);
+    return sound;
+}
+
+Music AssetScope::loadMusic(const char url[])
+{
+    Music music = AssetCache::instance().loadMusic(url);
+    musics.push_back(music);
+    return music;
+}
+
+void AssetScope::track(Texture2D texture)
+{
+    textures.push_back(texture);
+}
+
+void AssetScope::track(Sound sound)
+{
+    sounds.push_back(sound);
+}
+
+void AssetScope::track(Music music)
+{
+    musics.push_back(music);
+}
+
+void AssetScope::release()
+{
+    AssetCache& cache = AssetCache::instance();
+
+    for (Texture2D texture : textures) cache.unloadTexture(texture);
+    for (Sound sound : sounds) cache.unloadSound(sound);
+    for (Music music : musics) cache.unloadMusic(music);
+
+    textures.clear();
+    sounds.clear();
+    musics.clear();
+}
+
+void AssetScope::swap(AssetScope& other)
+{
+    textures.swap(other.textures);
+    sounds.swap(other.sounds);
+    musics.swap(other.musics);
+}
+
+const char* AssetScope::getName() const
+{
+    return name;
+}
+
+int AssetScope::getCount() const
+{
+    return (int)(textures.size() + sounds.size() + musics.size());
+}
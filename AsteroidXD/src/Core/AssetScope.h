@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include "raylib.h"
+#include "AssetCache.h"
+
+/// <summary>
+/// Conjunto de referencias de AssetCache con el mismo tiempo de vida (toda la sesion, un nivel...).
+/// Lo que se carga por el scope se suelta junto con release(), el asset solo se descarga
+/// si nadie mas lo usa. Para cambiar de nivel sin recargar: se llena el scope nuevo
+/// antes de soltar el anterior, lo compartido sigue residente.
+/// </summary>
+class AssetScope
+{
+private:
+    const char* name;
+
+    std::vector<Texture2D> textures;
+    std::vector<Sound> sounds;
+    std::vector<Music> musics;
+
+public:
+    AssetScope(const char name[]);
+    ~AssetScope();
+
+    AssetScope(const AssetScope&) = delete;
+    AssetScope& operator=(const AssetScope&) = delete;
+
+    Texture2D loadTexture(const char url[]);
+    Sprite loadSprite(const char url[]);
+    Sound loadSound(const char url[]);
+    Music loadMusic(const char url[]);
+
+    /// <summary>
+    /// Pasa al scope una referencia que ya se tiene (por ejemplo de AssetCache::adoptTexture)
+    /// </summary>
+    /// <param name="texture"></param>
+    void track(Texture2D texture);
+    void track(Sound sound);
+    void track(Music music);
+
+    /// <summary>
+    /// Suelta todas las referencias del scope
+    /// </summary>
+    void release();
+
+    /// <summary>
+    /// Intercambia el contenido con otro scope, para reemplazar un nivel por el siguiente
+    /// </summary>
+    /// <param name="other"></param>
+    void swap(AssetScope& other);
+
+    const char* getName() const;
+    int getCount() const;
+};
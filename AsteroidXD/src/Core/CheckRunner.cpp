@@ -0,0 +1,258 @@
+#include "CheckRunner.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "Simulation/Simulation.h"
+
+// Shield lost by a ship that sits still inside big meteors for a second, at a given tick rate
+static int ShieldLostInASecond(int ticksPerSecond)
+{
+    SimConfig config;
+    config.shipMaxShield = 100000;
+    config.shipHitImpulse = 0.0f;
+    config.meteorsSpeed = 1.0f;
+
+    // Wherever they spawn, meteors this big cover the center of the screen where the ship starts
+    config.bigMeteorRadius = 700.0f;
+
+    Simulation simulation(config);
+    simulation.reset(1, 1);
+
+    SimInput input;
+    input.aim = simulation.getShip().position;
+
+    for (int tick = 0; tick < ticksPerSecond; tick++) simulation.step(input, 1.0f / ticksPerSecond);
+
+    return config.shipMaxShield - simulation.getShip().shield;
+}
+
+static bool CheckHitRate()
+{
+    const int at30 = ShieldLostInASecond(30);
+    const int at60 = ShieldLostInASecond(60);
+    const int at120 = ShieldLostInASecond(120);
+
+    printf("contact damage per second: %i at 30 Hz, %i at 60 Hz, %i at 120 Hz\n", at30, at60, at120);
+
+    return at60 > 0 && at30 == at60 && at120 == at60;
+}
+
+// Two shots on the same spot and a meteor that splits into fragments just as big as itself:
+// the first shot breaks the meteor and the second one has to break a fragment in the same tick
+static bool CheckStackedShots()
+{
+    SimConfig config;
+    config.shipMaxShield = 100000;
+    config.shipHitImpulse = 0.0f;
+    config.shootSpeed = 0.0f;
+    config.shootMaxLifeSpawn = 1000.0f;
+    config.meteorRadiusScale = 1.0f;
+
+    Simulation simulation(config);
+    simulation.reset(1, 7);
+
+    SimInput input;
+    input.aim = simulation.getShip().position;
+
+    for (int tick = 0; tick < 60 * 60; tick++)
+    {
+        // The ship stands still, both shots stay at its nose
+        input.fire = tick < 2;
+        simulation.step(input, 1.0f / 60.0f);
+
+        int destroyed = 0;
+
+        for (const SimEvent& e : simulation.getEvents())
+        {
+            if (e.type == SimEventType::MeteorDestroyed) destroyed++;
+        }
+
+        if (destroyed == 0) continue;
+
+        printf("stacked shots: %i meteors destroyed at tick %i\n", destroyed, tick);
+        return destroyed == 2;
+    }
+
+    printf("stacked shots: no meteor reached the shots\n");
+    return false;
+}
+
+// FNV-1a, the checksum of the snapshot header
+static uint32_t Checksum(const unsigned char* data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < size; i++) hash = (hash ^ data[i]) * 16777619u;
+
+    return hash;
+}
+
+// A snapshot with a repeated slot in a free list and a valid checksum has to be rejected
+// without touching the match that tried to load it
+static bool CheckCorruptSnapshot()
+{
+    // Magic, version, payload size and checksum
+    const size_t headerSize = 16;
+    const size_t checksumOffset = 12;
+
+    SimConfig config;
+    Simulation source(config);
+    source.reset(3, 11);
+
+    std::vector<unsigned char> corrupt(source.getSnapshotSize());
+    source.saveSnapshot(corrupt.data(), corrupt.size());
+
+    // Right after a reset the shoot pool hands out its slots in order, look for that free list
+    const int shoots = config.shipMaxShoots;
+    std::vector<int32_t> freeList(shoots);
+    for (int i = 0; i < shoots; i++) freeList[i] = i;
+
+    const size_t listSize = freeList.size() * sizeof(int32_t);
+    size_t offset = 0;
+
+    while (offset + listSize <= corrupt.size() && memcmp(corrupt.data() + offset, freeList.data(), listSize) != 0) offset++;
+
+    if (offset + listSize > corrupt.size())
+    {
+        printf("corrupt snapshot: shoot free list not found\n");
+        return false;
+    }
+
+    const int32_t repeated = 0;
+    memcpy(corrupt.data() + offset + sizeof(int32_t), &repeated, sizeof(repeated));
+
+    const uint32_t checksum = Checksum(corrupt.data() + headerSize, corrupt.size() - headerSize);
+    memcpy(corrupt.data() + checksumOffset, &checksum, sizeof(checksum));
+
+    // Another match in mid play
+    Simulation target(config);
+    target.reset(5, 23);
+
+    SimInput input;
+    input.aim = Vector2{ 0.0f, 0.0f };
+    input.fire = true;
+
+    for (int tick = 0; tick < 90; tick++) target.step(input, 1.0f / 60.0f);
+
+    std::vector<unsigned char> before(target.getSnapshotSize());
+    target.saveSnapshot(before.data(), before.size());
+
+    const bool loaded = target.loadSnapshot(corrupt.data(), corrupt.size());
+
+    std::vector<unsigned char> after(target.getSnapshotSize());
+    target.saveSnapshot(after.data(), after.size());
+
+    const bool unchanged = before == after;
+    printf("corrupt snapshot: %s, match %s\n", loaded ? "loaded" : "rejected", unchanged ? "unchanged" : "changed");
+
+    return !loaded && unchanged;
+}
+
+// Split settings out of range are clamped: the match plays, fragments have a size and snapshots round trip
+static bool CheckSplitConfig()
+{
+    struct Case
+    {
+        int splitFactor;
+        float radiusScale;
+    };
+
+    const Case cases[] =
+    {
+        { -3, 0.5f },
+        { 100000, 0.5f },
+        { 2, 0.0f },
+        { 2, -1.0f },
+        { 2, NAN },
+    };
+
+    bool passed = true;
+
+    for (const Case& c : cases)
+    {
+        SimConfig config;
+        config.shipMaxShield = 100000;
+        config.meteorSplitFactor = c.splitFactor;
+        config.meteorRadiusScale = c.radiusScale;
+
+        Simulation simulation(config);
+        simulation.reset(1, 5);
+
+        SimInput input;
+        int destroyed = 0;
+
+        for (int tick = 0; tick < 1200; tick++)
+        {
+            const float angle = tick * 0.05f;
+            input.aim = Vector2{ config.width * 0.5f + cosf(angle) * 200.0f, config.height * 0.5f + sinf(angle) * 200.0f };
+            input.fire = tick % 4 == 0;
+            simulation.step(input, 1.0f / 60.0f);
+
+            for (const SimEvent& e : simulation.getEvents())
+            {
+                if (e.type == SimEventType::MeteorDestroyed) destroyed++;
+            }
+        }
+
+        const SimConfig& clamped = simulation.getConfig();
+        const MeteorField& meteors = simulation.getMeteors();
+        bool sized = true;
+
+        for (int i = 0; i < meteors.size(); i++)
+        {
+            if (meteors.active[i] && !(meteors.radius[i] > 0.0f)) sized = false;
+        }
+
+        // Loading runs the config through the same clamps
+        std::vector<unsigned char> saved(simulation.getSnapshotSize());
+        simulation.saveSnapshot(saved.data(), saved.size());
+
+        Simulation restored(SimConfig{});
+        const bool loaded = restored.loadSnapshot(saved.data(), saved.size());
+
+        std::vector<unsigned char> resaved(restored.getSnapshotSize());
+        restored.saveSnapshot(resaved.data(), resaved.size());
+
+        const bool ok = clamped.meteorSplitFactor >= 1 && clamped.meteorSplitFactor <= 255 && clamped.meteorRadiusScale > 0.0f
+            && sized && destroyed > 0 && loaded && saved == resaved;
+
+        printf("split %i scale %g: clamped to %i and %g, %i meteors destroyed, %s\n", c.splitFactor, c.radiusScale,
+            clamped.meteorSplitFactor, clamped.meteorRadiusScale, destroyed, ok ? "ok" : "wrong");
+
+        passed = passed && ok;
+    }
+
+    return passed;
+}
+
+int RunChecks()
+{
+    struct Check
+    {
+        const char* name;
+        bool (*run)();
+    };
+
+    const Check checks[] =
+    {
+        { "hit rate", CheckHitRate },
+        { "stacked shots", CheckStackedShots },
+        { "corrupt snapshot", CheckCorruptSnapshot },
+        { "split config", CheckSplitConfig },
+    };
+
+    int failed = 0;
+
+    for (const Check& check : checks)
+    {
+        const bool passed = check.run();
+        printf("%-32s %s\n", check.name, passed ? "ok" : "FAILED");
+
+        if (!passed) failed++;
+    }
+
+    printf("%i of %i checks failed\n", failed, (int)(sizeof(checks) / sizeof(checks[0])));
+
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#pragma region FUNCTIONS
+
+/// <summary>
+/// Comprobaciones de la simulacion sin ventana: reglas que no tienen que depender del tick,
+/// casos borde de las colisiones y de los snapshots. Imprime una linea por comprobacion.
+/// </summary>
+/// <returns>Codigo de salida del proceso, distinto de 0 si alguna falla</returns>
+int RunChecks();
+
+#pragma endregion
@@ -0,0 +1,172 @@
+#include "CoopRunner.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "Net/LoopbackTransport.h"
+#include "Net/RollbackSession.h"
+#include "Net/UdpTransport.h"
+#include "Simulation/Simulation.h"
+
+static const float simulationStep = 1.0f / 120.0f;
+static const uint64_t coopSeed = 20210601;
+static const uint16_t hostPort = 47777;
+static const uint16_t guestPort = 47778;
+
+// Delays tried for every run, from none to a tenth of a second at 120 Hz
+static const int testDelays[] = { 0, 1, 2, 3, 4, 6, 8, 12 };
+
+// Always the same input for a player and frame: each aim goes around the centre at its own pace,
+// with thrust bursts and a shot every quarter second, out of phase between the players
+static SimInput ScriptedInput(int player, int frame)
+{
+    const float angle = frame * (0.01f + player * 0.004f) + player * 3.0f;
+
+    SimInput input;
+    input.aim = Vector2{ 512.0f + cosf(angle) * 220.0f, 360.0f + sinf(angle) * 200.0f };
+    input.thrust = ((frame + player * 90) / 120) % 3 == 0;
+    input.fire = (frame + player * 15) % 30 == 0;
+
+    return input;
+}
+
+// Both ends of the link, in memory or through the loopback interface
+static bool OpenTransports(bool udp, std::unique_ptr<Transport>& host, std::unique_ptr<Transport>& guest)
+{
+    if (!udp)
+    {
+        LoopbackTransport* hostEnd = new LoopbackTransport();
+        LoopbackTransport* guestEnd = new LoopbackTransport();
+        host.reset(hostEnd);
+        guest.reset(guestEnd);
+        LoopbackTransport::connect(*hostEnd, *guestEnd);
+        return true;
+    }
+
+    UdpTransport* hostEnd = new UdpTransport();
+    UdpTransport* guestEnd = new UdpTransport();
+    host.reset(hostEnd);
+    guest.reset(guestEnd);
+
+    return hostEnd->open(hostPort, "127.0.0.1", guestPort) && guestEnd->open(guestPort, "127.0.0.1", hostPort);
+}
+
+int RunCoopTest(int frames, const NetConditions& conditions, bool udp)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    SimConfig config;
+    config.players = 2;
+
+    int exitCode = 0;
+    int recommendedDelay = 0;
+
+    printf("coop %i frames, latency %.0f ms, jitter %.0f ms, loss %.0f%%, %s\n", frames,
+        conditions.latency * 1000.0, conditions.jitter * 1000.0, conditions.loss * 100.0f, udp ? "udp 127.0.0.1" : "loopback");
+
+    printf("%6s %8s %10s %10s %10s %10s %10s %8s %8s %10s %s\n",
+        "delay", "stalls", "rollbacks", "avg depth", "max depth", "resim", "resim/s", "rtt ms", "lost", "us/frame", "result");
+
+    for (int delay : testDelays)
+    {
+        std::unique_ptr<Transport> hostTransport;
+        std::unique_ptr<Transport> guestTransport;
+
+        if (!OpenTransports(udp, hostTransport, guestTransport))
+        {
+            printf("could not open udp ports %i and %i\n", hostPort, guestPort);
+            return 1;
+        }
+
+        hostTransport->setConditions(conditions, 1);
+        guestTransport->setConditions(conditions, 2);
+
+        RollbackSettings settings;
+        settings.inputDelay = delay;
+        settings.step = simulationStep;
+
+        Simulation hostSimulation(config);
+        Simulation guestSimulation(config);
+        RollbackSession host(hostSimulation, *hostTransport, 0, settings);
+        RollbackSession guest(guestSimulation, *guestTransport, 1, settings);
+        RollbackSession* sessions[] = { &host, &guest };
+
+        host.host(1, coopSeed);
+        guest.join();
+
+        // A virtual clock at the tick rate, both peers advance once per tick like two games at full speed
+        const long long maxTicks = (long long)frames * 4 + 2000;
+        long long tick = 0;
+        double advanceSeconds = 0.0;
+
+        for (; tick < maxTicks; tick++)
+        {
+            const double now = tick * (double)simulationStep;
+            bool done = true;
+
+            for (int player = 0; player < 2; player++)
+            {
+                RollbackSession& session = *sessions[player];
+
+                if (session.getFrame() < frames)
+                {
+                    Clock::time_point start = Clock::now();
+                    session.advance(ScriptedInput(player, session.getFrame()), now);
+                    advanceSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+                }
+                else session.poll(now);
+
+                done = done && session.getFrame() >= frames && session.isConfirmed();
+            }
+
+            if (done) break;
+        }
+
+        // Every input arrived on both sides, so both peers must hold the very same state
+        std::vector<unsigned char> hostState(hostSimulation.getSnapshotSize());
+        std::vector<unsigned char> guestState(guestSimulation.getSnapshotSize());
+        hostSimulation.saveSnapshot(hostState.data(), hostState.size());
+        guestSimulation.saveSnapshot(guestState.data(), guestState.size());
+
+        const char* result = "match";
+
+        if (tick >= maxTicks)
+        {
+            result = "timeout";
+            exitCode = 1;
+        }
+        else if (hostState != guestState)
+        {
+            result = "DESYNC";
+            exitCode = 1;
+        }
+
+        const RollbackStats& hostStats = host.getStats();
+        const RollbackStats& guestStats = guest.getStats();
+
+        const unsigned long long rollbacks = hostStats.rollbacks + guestStats.rollbacks;
+        const unsigned long long resimulated = hostStats.resimulatedFrames + guestStats.resimulatedFrames;
+        const double gameSeconds = 2.0 * frames * simulationStep;
+
+        printf("%6i %8llu %10llu %10.2f %10i %10llu %10.1f %8.1f %8u %10.2f %s\n",
+            delay,
+            hostStats.stalls + guestStats.stalls,
+            rollbacks,
+            rollbacks > 0 ? (double)resimulated / rollbacks : 0.0,
+            hostStats.maxRollbackDepth > guestStats.maxRollbackDepth ? hostStats.maxRollbackDepth : guestStats.maxRollbackDepth,
+            resimulated,
+            resimulated / gameSeconds,
+            hostStats.roundTrip * 1000.0,
+            hostTransport->getStats().lost + guestTransport->getStats().lost,
+            advanceSeconds * 1e6 / (2.0 * frames),
+            result);
+
+        recommendedDelay = host.getRecommendedDelay();
+    }
+
+    printf("recommended delay for the measured round trip: %i frames\n", recommendedDelay);
+
+    return exitCode;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "Net/Transport.h"
+
+#pragma region FUNCTIONS
+
+/// <summary>
+/// Juega una partida cooperativa scripteada entre dos sesiones de rollback del mismo proceso,
+/// una vez por cada demora de entrada, y compara el estado final de los dos pares.
+/// Informa stalls, rollbacks, profundidad, frames resimulados por segundo y el costo por frame,
+/// asi se elige la demora para una latencia y una perdida dadas.
+/// </summary>
+/// <param name="frames">Frames de cada partida</param>
+/// <param name="conditions">Latencia, jitter y perdida de cada direccion</param>
+/// <param name="udp">Usa sockets UDP en 127.0.0.1 en lugar del transporte en memoria</param>
+/// <returns>Codigo de salida del proceso, distinto de 0 si los pares terminan distintos</returns>
+int RunCoopTest(int frames, const NetConditions& conditions, bool udp);
+
+#pragma endregion
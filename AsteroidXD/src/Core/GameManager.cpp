@@ -1,5 +1,6 @@
 #include "GameManager.h"
 #include "raylib.h"
+#include <ctime>
 #include <string>
 #include <vector>
 #include "Class/GameObjects/Ship.h"
@@ -8,6 +9,18 @@
 #include "Class/UIObjects/Button.h"
 #include "Class/UIObjects/ProgressBar.h"
 #include "Class/GameObjects/HpPowerUp.h"
+#include "Simulation/Simulation.h"
+#include "Simulation/InputRecording.h"
+#include "Core/AssetCache.h"
+#include "Core/AssetArchive.h"
+#include "Core/AssetLoader.h"
+#include "Core/AssetScope.h"
+#include "Core/RenderQueue.h"
+#include "Core/VoicePool.h"
+#include "Net/RollbackSession.h"
+#include "Net/UdpTransport.h"
+#include "Utils/ByteStream.h"
+#include "Utils/Profiler.h"
 
 #pragma region CONSTANT VARIABLES
 
@@ -17,11 +30,8 @@ static const int screenWidth = 1024;
 static const int screenHeight = 720;
 static bool isFullScreen = false;
 
-static const int shipMaxShoots = 10;
-static const int shipMaxShield = 100;
-static const float shipRadius = 18.0f;
-
-static const float meteorsSpeed = 150.0f;
+// Stress mode: amount of big meteors to spawn on every level, 0 plays the normal levels
+static const int stressMeteors = 0;
 
 static const char tutorialText[] = R"(
 Destruye todos los asteroides para superar el nivel,
@@ -38,6 +48,11 @@ Comportamiento de la nave:
 - Boton derecho del mouse para acelerar.
 - Boton izquierdo del mouse para disparar.
 
+F5 guarda la partida y F9 la retoma desde ese punto.
+
+Cooperativo (--coop 1 y --coop 2 en la misma PC): cada uno vuela su nave,
++ y - cambian la demora de la entrada.
+
 DISFRUTA EL JUEGO xD
 )";
 
@@ -68,6 +83,7 @@ Musica:
 
 enum class GameState
 {
+    Loading,
     MainMenu,
     Gameplay,
     Tutorial,
@@ -79,17 +95,64 @@ enum class GameState
 
 #pragma region GLOBAL VARIABLES
 
-static GameState gameState = GameState::MainMenu;
-static bool gameOver = false;
+static GameState gameState = GameState::Loading;
 static bool pause = false;
-static bool victory = false;
 static int level = 1;
 
+static Simulation simulation;
+static unsigned long long matchCount = 0;
+
+// Fixed timestep: the simulation always advances in ticks of simulationStep,
+// the draw interpolates between the last two ticks
+static const float simulationStep = 1.0f / 120.0f;
+static const int maxStepsPerFrame = 8;
+static float simulationAccumulator = 0.0f;
+static bool pendingFire = false;
+
+// Input recording: one file per attempt, replayed headless with --replay
+static bool recordInputs = false;
+static InputRecording recording;
+static int savedRecordings = 0;
+
+// Co-op (AsteroidXD --coop 1|2): two instances on this machine, each one flies its own ship
+// and the rollback session keeps both simulations together. The first player hosts
+static const uint16_t coopPorts[2] = { 7777, 7778 };
+static const double coopSilenceWarning = 2.0;
+static int coopPlayer = -1;
+static UdpTransport coopTransport;
+static RollbackSession* coopSession = nullptr;
+
+// Checkpoint of the last simulated frame: this file's flags and the simulation snapshot.
+// Taken every frame (a few microseconds), F5 writes it to quickSaveUrl and F9 resumes from the file
+static const char quickSaveUrl[] = "quicksave.axds";
+static const char checkpointMagic[4] = { 'A', 'X', 'D', 'G' };
+static const uint32_t checkpointVersion = 1;
+static const size_t checkpointHeaderSize = 18;
+static std::vector<unsigned char> checkpoint;
+static size_t checkpointSize = 0;
+
+// Packed resources (AsteroidXD --pack), when missing the loader reads the loose files.
+// Declared before the loader so its threads are joined before the mapping goes away
+static const char archiveUrl[] = "resources.axdp";
+static AssetArchive archive;
+
+// Every asset is decoded by the loader threads while the loading screen keeps drawing,
+// the main thread only spends loadingBudget seconds per frame uploading them
+static AssetLoader loader;
+static const double loadingBudget = 0.008;
+static ProgressBar* loadingBar;
+
+// Asset lifetimes: the global scope lives the whole session (crosshairs, parallax, music),
+// the level scope is refilled on every InitGame before the previous one is released,
+// so retries and the next level never decode again and the footprint stays flat
+static AssetScope globalAssets("global");
+static AssetScope levelAssets("level");
+
 static const char crosshair1Url[] = "resources/images/crosshair158.png";
 static const char crosshair2Url[] = "resources/images/crosshair185.png";
 
-static Texture2D crosshair1;
-static Texture2D crosshair2;
+static Sprite crosshair1;
+static Sprite crosshair2;
 static float crosshair1Rot = 0.0f;
 static float crosshair2Rot = 0.0f;
 
@@ -118,12 +181,14 @@ static Music gameplayMusic;
 // Player Ship and shoots---------------------------
 static const char shipImgUrl[] = "resources/images/ship_G.png";
 static Ship* player;
+static Ship* partner;
 static const char engineSfxUrl[] = "resources/sfx/engineCircular_000.ogg";
 static const char shieldSfxUrl[] = "resources/sfx/forceField_000.ogg";
 static const char explodeShipSfxUrl[] = "resources/sfx/explosionCrunch_004.ogg";
-static std::vector<Shoot*> shoot;
+static Shoot* shootView;
+static Shoot* partnerShootView;
 static const char laserSfxUrl[] = "resources/sfx/laserLarge_000.ogg";
-static Sound laserSfx;
+static int laserSample;
 static HpPowerUp* hpPowerUp;
 static const char hpSpriteUrl[] = "resources/images/icon_plusSmall.png";
 static const char hpSfxUrl[] = "resources/sfx/question_003.ogg";
@@ -132,18 +197,18 @@ static const char hpSfxUrl[] = "resources/sfx/question_003.ogg";
 // Meteors------------------------------------------
 static const char meteorImgUrl[] = "resources/images/meteor_detailedLarge.png";
 static const char meteorExplodeSfxUrl[] = "resources/sfx/explosionCrunch_000.ogg";
-static std::vector<Meteor*> bigMeteor;
-static std::vector<Meteor*> mediumMeteor;
-static std::vector<Meteor*> smallMeteor;
-
-static const int baseAmountBigMeteors = 4;
-static int maxBigMeteors = baseAmountBigMeteors;
-static int maxMediumMeteors = maxBigMeteors * 2;
-static int maxSmallMeteors = maxMediumMeteors * 2;
-
-static int midMeteorsCount = 0;
-static int smallMeteorsCount = 0;
-static int destroyedMeteorsCount = 0;
+static Meteor* meteorView;
+//-------------------------------------------------
+
+// Sound voices------------------------------------
+// Instances a sample can overlap, who keeps its voice when the pool is full and volume.
+// The loader uploads that many buffers of each file so the pool never decodes during play
+static const int voiceLimit = 8;
+static const SampleSettings laserVoices{ 3, 1, 0.5f };
+static const SampleSettings meteorExplodeVoices{ 4, 0, 1.0f };
+static const SampleSettings shieldVoices{ 1, 2, 0.65f };
+static const SampleSettings explodeShipVoices{ 1, 3, 0.65f };
+static const SampleSettings hpVoices{ 1, 2, 1.0f };
 //-------------------------------------------------
 
 // HUD
@@ -166,63 +231,197 @@ static Button* returnMenuButton;
 
 #pragma endregion
 
-// Initialize game variables
-static void InitGame()
+// Save the inputs of the attempt that just ended
+static void SaveRecording()
 {
-    float posx, posy;
-    float velx, vely;
-    bool correctRange = false;
-    gameOver = false;
-    victory = false;
-    pause = false;
+    if (!recordInputs || recording.inputs.empty()) return;
 
-    crosshair1 = LoadTexture(crosshair1Url);
-    crosshair2 = LoadTexture(crosshair2Url);
+    const char* fileName = TextFormat("replay_%03i_level%i.axdr", savedRecordings++, recording.level);
 
-    background = LoadTexture(backgroundUrl);
-    midground = LoadTexture(midgroundUrl);
+    if (recording.save(fileName)) TraceLog(LOG_INFO, "REPLAY: Saved %i ticks to %s", (int)recording.inputs.size(), fileName);
+    else TraceLog(LOG_WARNING, "REPLAY: Could not write %s", fileName);
 
-#pragma region Audio
+    recording.inputs.clear();
+}
 
-    if (!IsAudioDeviceReady())
+// Keep the state after this frame's ticks, the buffer only grows when the meteor field does
+static void SaveCheckpoint()
+{
+    const size_t needed = checkpointHeaderSize + simulation.getSnapshotSize();
+    if (checkpoint.size() < needed) checkpoint.resize(needed * 2);
+
+    ByteWriter header(checkpoint.data(), checkpointHeaderSize);
+    for (char c : checkpointMagic) header.write(c);
+    header.write(checkpointVersion);
+    header.write((int32_t)level);
+    header.write((unsigned char)(pause ? 1 : 0));
+    header.write((unsigned char)(pendingFire ? 1 : 0));
+    header.write(simulationAccumulator);
+
+    const size_t written = simulation.saveSnapshot(checkpoint.data() + checkpointHeaderSize, checkpoint.size() - checkpointHeaderSize);
+    checkpointSize = (written > 0) ? checkpointHeaderSize + written : 0;
+}
+
+static bool RestoreCheckpoint(const unsigned char* data, size_t size)
+{
+    if (size < checkpointHeaderSize) return false;
+
+    ByteReader header(data, checkpointHeaderSize);
+
+    for (char c : checkpointMagic)
     {
-        InitAudioDevice();
+        if (header.read<char>() != c) return false;
+    }
+
+    if (header.read<uint32_t>() != checkpointVersion) return false;
 
-        mainMusic = LoadMusicStream(mainMusicUrl);
-        SetMusicVolume(mainMusic, 0.15f);
+    const int32_t savedLevel = header.read<int32_t>();
+    const bool savedPause = header.read<unsigned char>() != 0;
+    const bool savedFire = header.read<unsigned char>() != 0;
+    const float savedAccumulator = header.read<float>();
 
-        gameplayMusic = LoadMusicStream(gameplayMusicUrl);
-        SetMusicVolume(gameplayMusic, 0.15f);
+    if (!simulation.loadSnapshot(data + checkpointHeaderSize, size - checkpointHeaderSize)) return false;
 
-        laserSfx = LoadSound(laserSfxUrl);
-        SetSoundVolume(laserSfx, 0.5f);
+    level = savedLevel;
+    pause = savedPause;
+    pendingFire = savedFire;
+    simulationAccumulator = savedAccumulator;
+
+    return true;
+}
+
+static void QuickSave()
+{
+    if (checkpointSize == 0) return;
+
+    if (SaveFileData(quickSaveUrl, checkpoint.data(), (unsigned int)checkpointSize)) TraceLog(LOG_INFO, "SAVE: Level %i tick %llu saved to %s (%i bytes)", level, simulation.getTick(), quickSaveUrl, (int)checkpointSize);
+    else TraceLog(LOG_WARNING, "SAVE: Could not write %s", quickSaveUrl);
+}
+
+static void QuickLoad()
+{
+    // A recording always starts from reset(), a resumed match could not be replayed
+    if (recordInputs)
+    {
+        TraceLog(LOG_WARNING, "SAVE: Resuming is disabled while recording inputs");
+        return;
     }
 
-#pragma endregion
+    if (!FileExists(quickSaveUrl)) return;
+
+    unsigned int size = 0;
+    unsigned char* data = LoadFileData(quickSaveUrl, &size);
+
+    if (data != nullptr && RestoreCheckpoint(data, size))
+    {
+        gameState = GameState::Gameplay;
+        HideCursor();
+        TraceLog(LOG_INFO, "SAVE: Resumed level %i at tick %llu", level, simulation.getTick());
+    }
+    else TraceLog(LOG_WARNING, "SAVE: %s is not a valid save of this version", quickSaveUrl);
+
+    if (data != nullptr) UnloadFileData(data);
+}
+
+// Queue every file the game uses so the loader decodes them in the background
+static void QueueAssets()
+{
+    // Sprites share one atlas texture, the parallax layers are too big and repeat so they stay apart
+    loader.queueSprite(crosshair1Url);
+    loader.queueSprite(crosshair2Url);
+    loader.queueSprite(shipImgUrl);
+    loader.queueSprite(hpSpriteUrl);
+    loader.queueSprite(meteorImgUrl);
+    loader.queueTexture(backgroundUrl);
+    loader.queueTexture(midgroundUrl);
+
+    loader.queueMusic(mainMusicUrl);
+    loader.queueMusic(gameplayMusicUrl);
+
+    loader.queueSound(engineSfxUrl);
+    loader.queueSound(shieldSfxUrl, shieldVoices.maxInstances);
+    loader.queueSound(explodeShipSfxUrl, explodeShipVoices.maxInstances);
+    loader.queueSound(laserSfxUrl, laserVoices.maxInstances);
+    loader.queueSound(hpSfxUrl, hpVoices.maxInstances);
+    loader.queueSound(meteorExplodeSfxUrl, meteorExplodeVoices.maxInstances);
+    loader.queueSound(playSfxUrl);
+    loader.queueSound(clickSfxUrl);
+    loader.queueSound(tutorialSfxUrl);
+}
+
+// Take the session-wide assets once, after the loading screen
+static void LoadGlobalAssets()
+{
+    crosshair1 = globalAssets.loadSprite(crosshair1Url);
+    crosshair2 = globalAssets.loadSprite(crosshair2Url);
+
+    background = globalAssets.loadTexture(backgroundUrl);
+    midground = globalAssets.loadTexture(midgroundUrl);
+
+    mainMusic = globalAssets.loadMusic(mainMusicUrl);
+    SetMusicVolume(mainMusic, 0.15f);
+
+    gameplayMusic = globalAssets.loadMusic(gameplayMusicUrl);
+    SetMusicVolume(gameplayMusic, 0.15f);
+
+    // Registered before the views so they find their samples already configured
+    VoicePool& voices = VoicePool::instance();
+    voices.setVoiceLimit(voiceLimit);
+
+    laserSample = voices.addSample(laserSfxUrl, laserVoices);
+    voices.addSample(meteorExplodeSfxUrl, meteorExplodeVoices);
+    voices.addSample(shieldSfxUrl, shieldVoices);
+    voices.addSample(explodeShipSfxUrl, explodeShipVoices);
+    voices.addSample(hpSfxUrl, hpVoices);
+}
+
+// Take the assets of the level that starts, then drop the ones of the previous attempt
+static void LoadLevelAssets()
+{
+    AssetScope previousLevel("level");
+    previousLevel.swap(levelAssets);
+
+    levelAssets.loadSprite(shipImgUrl);
+    levelAssets.loadSprite(meteorImgUrl);
+    levelAssets.loadSprite(hpSpriteUrl);
+    levelAssets.loadSound(engineSfxUrl);
+
+    previousLevel.release();
+
+    AssetCache::instance().logResident(LOG_DEBUG, TextFormat("Level %i", level));
+}
+
+// Initialize game variables
+static void InitGame()
+{
+    pause = false;
+
+    LoadLevelAssets();
 
 #pragma region Player Shoots and Powerups
 
     // Initialization player
     if(player == nullptr)
     {
-        player = new Ship(Vector2{ GetScreenWidth() / 2 - shipRadius / 2, GetScreenHeight() / 2 - shipRadius / 2 }, shipImgUrl, engineSfxUrl, shieldSfxUrl, explodeShipSfxUrl);
+        player = new Ship(Vector2{ 0, 0 }, shipImgUrl, engineSfxUrl, shieldSfxUrl, explodeShipSfxUrl);
     }
-    else
+
+    if (hpPowerUp == nullptr)
     {
-        player->setPosition(Vector2{ GetScreenWidth() / 2 - shipRadius / 2, GetScreenHeight() / 2 - shipRadius / 2 });
-        player->resetState();
+        hpPowerUp = new HpPowerUp(hpSpriteUrl, hpSfxUrl);
     }
 
-    if (hpPowerUp == nullptr)
+    if (shootView == nullptr)
     {
-        hpPowerUp = new HpPowerUp({ 0,0 }, hpSpriteUrl, hpSfxUrl, { 0,0 }, meteorsSpeed, 0, shipRadius, false);
+        shootView = new Shoot(WHITE);
     }
 
-    for (Shoot* s : shoot)
+    if (coopSession != nullptr && partner == nullptr)
     {
-        delete s;
+        // Its own engine voice, the sound of one ship must not follow the other one
+        partner = new Ship(Vector2{ 0, 0 }, shipImgUrl, AssetCache::voiceUrl(engineSfxUrl, 1).c_str(), shieldSfxUrl, explodeShipSfxUrl, SKYBLUE);
+        partnerShootView = new Shoot(SKYBLUE);
     }
-    shoot.clear();
 
 #pragma endregion
 
@@ -336,162 +535,228 @@ static void InitGame()
 
 #pragma endregion
 
-#pragma region Meteors
+#pragma region Simulation
 
-    destroyedMeteorsCount = 0;
-
-    // Initialization shoot
-    for (int i = 0; i < shipMaxShoots; i++)
+    if (meteorView == nullptr)
     {
-        shoot.push_back(new Shoot(Vector2{ 0, 0 }, Vector2{ 0, 0 }, 2, 0, 0, false, WHITE));
+        meteorView = new Meteor(meteorImgUrl, meteorExplodeSfxUrl);
     }
 
-    // Reset all arrays of poiters
+    SimConfig config;
+    config.width = (float)GetScreenWidth();
+    config.height = (float)GetScreenHeight();
+    config.stressMeteors = stressMeteors;
+    config.players = (coopSession != nullptr) ? 2 : 1;
 
-    for (Meteor* m : bigMeteor)
-    {
-        delete m;
-    }
+    // The same simulation for every attempt, reset reuses what the last one allocated
+    simulation.setConfig(config);
 
-    bigMeteor.clear();
+    // Every attempt gets its own layout, the seed is all it takes to replay it
+    simulation.reset(level, ((unsigned long long)time(nullptr) << 16) + matchCount++);
 
-    for (Meteor* m : mediumMeteor)
+    if (coopSession != nullptr)
     {
-        delete m;
+        // The host picks the level and the seed, the guest plays whatever the host announces
+        if (coopPlayer == 0) coopSession->host(level, simulation.getSeed());
+        else coopSession->join();
     }
 
-    mediumMeteor.clear();
-    
-    for (Meteor* m : smallMeteor)
-    {
-        delete m;
-    }
+    SaveRecording();
+    if (recordInputs) recording.begin(config, level, simulation.getSeed(), simulationStep);
 
-    smallMeteor.clear();
-    //----------------------------
+    simulationAccumulator = 0.0f;
+    pendingFire = false;
 
-    maxBigMeteors = baseAmountBigMeteors * level;
-    maxMediumMeteors = maxBigMeteors * 2;
-    maxSmallMeteors = maxMediumMeteors * 2;
+#pragma endregion
 
-    for (int i = 0; i < maxBigMeteors; i++)
-    {
-        posx = GetRandomValue(0, GetScreenWidth());
+    HideCursor();
+}
 
-        while (!correctRange)
-        {
-            if (posx > GetScreenWidth() / 2 - 150 && posx < GetScreenWidth() / 2 + 150) posx = GetRandomValue(0, GetScreenWidth());
-            else correctRange = true;
-        }
+// Player this instance controls, the host is the first one
+static int LocalPlayer()
+{
+    return (coopPlayer < 0) ? 0 : coopPlayer;
+}
 
-        correctRange = false;
+static Ship* ShipView(int index)
+{
+    return (index == LocalPlayer() || partner == nullptr) ? player : partner;
+}
 
-        posy = GetRandomValue(0, GetScreenHeight());
+// In co-op the end of a level waits for every input of it, until then a prediction can still undo it
+static bool IsMatchLost()
+{
+    return simulation.isGameOver() && (coopSession == nullptr || coopSession->isConfirmed());
+}
 
-        while (!correctRange)
-        {
-            if (posy > GetScreenHeight() / 2 - 150 && posy < GetScreenHeight() / 2 + 150)  posy = GetRandomValue(0, GetScreenHeight());
-            else correctRange = true;
-        }
+static bool IsLevelCleared()
+{
+    return simulation.isVictory() && (coopSession == nullptr || coopSession->isConfirmed());
+}
 
+static void ReturnToMenu()
+{
+    // The other player keeps waiting for this one until it hosts or joins again
+    if (coopSession != nullptr) coopSession->stop();
 
-        correctRange = false;
-        velx = GetRandomValue(-meteorsSpeed, meteorsSpeed);
-        vely = GetRandomValue(-meteorsSpeed, meteorsSpeed);
+    gameState = GameState::MainMenu;
+}
 
-        while (!correctRange)
+// Play the sounds and effects of the last simulation step
+static void PlaySimulationEvents()
+{
+    for (const SimEvent& e : simulation.getEvents())
+    {
+        switch (e.type)
         {
-            if (velx == 0 && vely == 0)
-            {
-                velx = GetRandomValue(-meteorsSpeed, meteorsSpeed);
-                vely = GetRandomValue(-meteorsSpeed, meteorsSpeed);
-            }
-            else correctRange = true;
+        case SimEventType::ShootFired:
+            VoicePool::instance().play(laserSample, e.pitch);
+            break;
+        case SimEventType::MeteorDestroyed:
+            meteorView->explode(e.pitch);
+            break;
+        case SimEventType::ShipDamaged:
+            ShipView(e.player)->onDamaged(e.pitch);
+            break;
+        case SimEventType::ShipDestroyed:
+            ShipView(e.player)->onDestroyed();
+            break;
+        case SimEventType::PowerUpCollected:
+            hpPowerUp->collect();
+            break;
         }
-
-        bigMeteor.push_back(new Meteor(Vector2{ posx, posy }, meteorImgUrl, meteorExplodeSfxUrl, Vector2{ velx, vely }, meteorsSpeed, GetRandomValue(0, 360), 40, true));
-    }
-
-    for (int i = 0; i < maxMediumMeteors; i++)
-    {
-        mediumMeteor.push_back(new Meteor(Vector2{ -100, -100 }, meteorImgUrl, meteorExplodeSfxUrl, Vector2{ 0,0 }, meteorsSpeed, GetRandomValue(0, 360), 20, false));
-    }
-
-    for (int i = 0; i < maxSmallMeteors; i++)
-    {
-        smallMeteor.push_back(new Meteor(Vector2{ -100, -100 }, meteorImgUrl, meteorExplodeSfxUrl, Vector2{ 0,0 }, meteorsSpeed, GetRandomValue(0, 360), 10, false));
     }
+}
 
-    midMeteorsCount = 0;
-    smallMeteorsCount = 0;
-
-#pragma endregion
-
-    HideCursor();
+// Position to draw an entity between the last two simulation ticks
+static Vector2 RenderPosition(Vector2 previous, Vector2 current)
+{
+    return simulation.interpolate(previous, current, simulationAccumulator / simulationStep);
 }
 
 // Update game (one frame)
 static void UpdateGame()
 {
+    PROFILE_SCOPE("UpdateGame");
+
 #pragma region Parallax Update
 
-    scrollingBack -= 0.1f;
-    scrollingMid -= 0.5f;
+    scrollingBack -= 6.0f * GetFrameTime();
+    scrollingMid -= 30.0f * GetFrameTime();
 
     if (scrollingBack <= -background.width * 2) scrollingBack = 0;
     if (scrollingMid <= -midground.width * 2) scrollingMid = 0;
 
 #pragma endregion
 
+#pragma region Save and resume
+
+    // A co-op match lives in both instances, only single player saves
+    if (coopSession == nullptr)
+    {
+        if (gameState == GameState::Gameplay && IsKeyPressed(KEY_F5)) QuickSave();
+        if ((gameState == GameState::Gameplay || gameState == GameState::MainMenu) && IsKeyPressed(KEY_F9)) QuickLoad();
+    }
+
+#pragma endregion
+
+#pragma region Co-op input delay
+
+    if (coopSession != nullptr && gameState == GameState::Gameplay)
+    {
+        if (IsKeyPressed(KEY_KP_ADD) || IsKeyPressed(KEY_EQUAL)) coopSession->setInputDelay(coopSession->getInputDelay() + 1);
+        if (IsKeyPressed(KEY_KP_SUBTRACT) || IsKeyPressed(KEY_MINUS)) coopSession->setInputDelay(coopSession->getInputDelay() - 1);
+    }
+
+#pragma endregion
 
     switch (gameState)
     {
-    case GameState::MainMenu:
+    case GameState::Loading:
 
-        if (!IsMusicPlaying(mainMusic)) 
+        loader.finalize(loadingBudget);
+        loadingBar->setProgressValue(loader.getProgress());
+
+        if (loader.isDone())
         {
-            StopMusicStream(gameplayMusic);
-            PlayMusicStream(mainMusic);
+            LoadGlobalAssets();
+            InitGame();
+
+            // From here on the scopes own everything that was preloaded
+            loader.release();
+            archive.close();
+            AssetCache::instance().logResident(LOG_INFO, "Loaded");
+
+            gameState = GameState::MainMenu;
         }
-        else UpdateMusicStream(mainMusic);
 
-        // Play button behaviour
-        playButton->update();
+        break;
+
+    case GameState::MainMenu:
 
-        if (playButton->isClick())
         {
-            InitGame();
-            gameState = GameState::Gameplay;
+            PROFILE_SCOPE("Update/Music");
+
+            if (!IsMusicPlaying(mainMusic)) 
+            {
+                StopMusicStream(gameplayMusic);
+                PlayMusicStream(mainMusic);
+            }
+            else UpdateMusicStream(mainMusic);
         }
 
-        tutorialButton->update();
-        if (tutorialButton->isClick()) gameState = GameState::Tutorial;
+        {
+            PROFILE_SCOPE("Update/UI");
 
-        creditsButton->update();
-        if (creditsButton->isClick()) gameState = GameState::Credits;
+            // Play button behaviour
+            playButton->update();
 
-        quitButton->update();
-        if (quitButton->isClick()) gameState = GameState::Quit;
+            if (playButton->isClick())
+            {
+                InitGame();
+                gameState = GameState::Gameplay;
+            }
+
+            tutorialButton->update();
+            if (tutorialButton->isClick()) gameState = GameState::Tutorial;
+
+            creditsButton->update();
+            if (creditsButton->isClick()) gameState = GameState::Credits;
+
+            quitButton->update();
+            if (quitButton->isClick()) gameState = GameState::Quit;
+        }
 
         break;
     case GameState::Gameplay:
 
-        if (!IsMusicPlaying(gameplayMusic)) 
         {
-            StopMusicStream(mainMusic);
-            PlayMusicStream(gameplayMusic); 
+            PROFILE_SCOPE("Update/Music");
+
+            if (!IsMusicPlaying(gameplayMusic)) 
+            {
+                StopMusicStream(mainMusic);
+                PlayMusicStream(gameplayMusic); 
+            }
+            else UpdateMusicStream(gameplayMusic);
         }
-        else UpdateMusicStream(gameplayMusic);
 
-        if (!gameOver)
+        if (!IsMatchLost())
         {
-            if (!victory)
+            if (!IsLevelCleared())
             {
-                pauseButton->update();
-                if (pauseButton->isClick()) pause = !pause;
+                PROFILE_SCOPE("Update/UI");
+
+                // A co-op match can not stop, the other player keeps going
+                if (coopSession == nullptr)
+                {
+                    pauseButton->update();
+                    if (pauseButton->isClick()) pause = !pause;
+                }
             }
             else
             {
+                PROFILE_SCOPE("Update/UI");
                 reTryButton->update();
                 returnMenuButton->update();
 
@@ -501,186 +766,60 @@ static void UpdateGame()
                     InitGame();
                 }
 
-                if (returnMenuButton->isClick()) gameState = GameState::MainMenu;
+                if (returnMenuButton->isClick()) ReturnToMenu();
             }
 
             if (!pause)
             {
-                player->update();
+                PROFILE_SCOPE("Update/Simulation");
 
-                hpPowerUp->update();
+                // The click is kept until a tick consumes it, a frame can run zero ticks
+                if (IsMouseButtonPressed(0)) pendingFire = true;
 
-                if (hpPowerUp->getActive())
-                {
-                    if (CheckCollisionCircles(player->getPosition(), player->getRadius(), hpPowerUp->getPosition(), hpPowerUp->getRadius()))
-                    {
-                        hpPowerUp->setActive(false);
-                        player->resetShield();
-                    }
-                }
+                simulationAccumulator += GetFrameTime();
+                int steps = 0;
 
-                // Player shoot logic
-                if (IsMouseButtonPressed(0))
+                while (simulationAccumulator >= simulationStep && steps < maxStepsPerFrame)
                 {
-                    for (int i = 0; i < shipMaxShoots; i++)
-                    {
-                        if (!shoot[i]->getActive())
-                        {
-                            shoot[i]->setPosition(
-                                Vector2
-                                {
-                                    player->getPosition().x + (float)sin(player->getRotation() * DEG2RAD) * player->getRadius(),
-                                    player->getPosition().y - (float)cos(player->getRotation() * DEG2RAD) * player->getRadius()
-                                }
-                            );
-
-
-                            shoot[i]->setActive(true);
-                            shoot[i]->setSpeed(player->getRotation(), player->getMaxSpeed());
-
-                            SetSoundPitch(laserSfx, ((float)GetRandomValue(0, 45) / 100) + 1);
-                            PlaySound(laserSfx);
-                            break;
-                        }
-                    }
-                }
+                    SimInput input;
+                    input.aim = GetMousePosition();
+                    input.thrust = IsMouseButtonDown(1);
+                    input.fire = pendingFire;
+                    pendingFire = false;
 
-                // Shoot life timer
-                for (int i = 0; i < shipMaxShoots; i++)
-                {
-                    if (shoot[i]->getActive()) shoot[i]->addLifeSpawn();
-                }
+                    if (recordInputs) recording.record(input);
 
-                // Shot logic
-                for (int i = 0; i < shipMaxShoots; i++)
-                {
-                    if (shoot[i]->getActive())
-                    {
-                        shoot[i]->update();
-                    }
-                }
+                    bool stepped = true;
 
-                for (int a = 0; a < maxBigMeteors; a++)
-                {
-                    if (CheckCollisionCircles(player->getPosition(), player->getRadius(), bigMeteor[a]->getPosition(), bigMeteor[a]->getRadius()) && bigMeteor[a]->getActive())
                     {
-                        gameOver = player->damageShip(bigMeteor[a]->getPosition());
-                    }
-                }
+                        PROFILE_SCOPE("Sim/Step");
 
-                for (int a = 0; a < maxMediumMeteors; a++)
-                {
-                    if (CheckCollisionCircles(player->getPosition(), player->getRadius(), mediumMeteor[a]->getPosition(), mediumMeteor[a]->getRadius()) && mediumMeteor[a]->getActive())
-                    {
-                        gameOver = player->damageShip(mediumMeteor[a]->getPosition());
+                        // The session waits while the other player is too far behind, then nothing new happened
+                        if (coopSession != nullptr) stepped = coopSession->advance(input, GetTime());
+                        else simulation.step(input, simulationStep);
                     }
-                }
 
-                for (int a = 0; a < maxSmallMeteors; a++)
-                {
-                    if (CheckCollisionCircles(player->getPosition(), player->getRadius(), smallMeteor[a]->getPosition(), smallMeteor[a]->getRadius()) && smallMeteor[a]->getActive())
+                    if (stepped)
                     {
-                        gameOver = player->damageShip(smallMeteor[a]->getPosition());
+                        PROFILE_SCOPE("Update/Events");
+                        PlaySimulationEvents();
                     }
-                }
 
-                // Meteors logic: big meteors
-                for (int i = 0; i < maxBigMeteors; i++)
-                {
-                    bigMeteor[i]->update();
+                    simulationAccumulator -= simulationStep;
+                    steps++;
                 }
 
-                // Meteors logic: medium meteors
-                for (int i = 0; i < maxMediumMeteors; i++)
-                {
-                    mediumMeteor[i]->update();
-                }
+                // Too far behind (breakpoint, window drag...), drop the time instead of spiraling
+                if (simulationAccumulator >= simulationStep) simulationAccumulator = 0.0f;
 
-                // Meteors logic: small meteors
-                for (int i = 0; i < maxSmallMeteors; i++)
+                if (steps > 0 && coopSession == nullptr)
                 {
-                    smallMeteor[i]->update();
+                    PROFILE_SCOPE("Update/Checkpoint");
+                    SaveCheckpoint();
                 }
 
-                // Collision logic: player-shoots vs meteors
-                for (int i = 0; i < shipMaxShoots; i++)
-                {
-                    if ((shoot[i]->getActive()))
-                    {
-                        for (int a = 0; a < maxBigMeteors; a++)
-                        {
-                            if (bigMeteor[a]->getActive() && CheckCollisionCircles(shoot[i]->getPosition(), shoot[i]->getRadius(), bigMeteor[a]->getPosition(), bigMeteor[a]->getRadius()))
-                            {
-                                shoot[i]->setActive(false);
-                                shoot[i]->resetLifeSpawn();
-                                bigMeteor[a]->explode();
-                                destroyedMeteorsCount++;
-
-                                for (int j = 0; j < 2; j++)
-                                {
-                                    if (midMeteorsCount % 2 == 0)
-                                    {
-                                        mediumMeteor[midMeteorsCount]->setPosition(bigMeteor[a]->getPosition());
-                                        mediumMeteor[midMeteorsCount]->setSpeedByAngle(shoot[i]->getRotation(), true);
-                                    }
-                                    else
-                                    {
-                                        mediumMeteor[midMeteorsCount]->setPosition(bigMeteor[a]->getPosition());
-                                        mediumMeteor[midMeteorsCount]->setSpeedByAngle(shoot[i]->getRotation());
-                                    }
-
-                                    mediumMeteor[midMeteorsCount]->setActive(true);
-                                    midMeteorsCount++;
-                                }
-
-                                a = maxBigMeteors;
-                            }
-                        }
-
-                        for (int b = 0; b < maxMediumMeteors; b++)
-                        {
-                            if (mediumMeteor[b]->getActive() && CheckCollisionCircles(shoot[i]->getPosition(), shoot[i]->getRadius(), mediumMeteor[b]->getPosition(), mediumMeteor[b]->getRadius()))
-                            {
-                                shoot[i]->setActive(false);
-                                shoot[i]->resetLifeSpawn();
-                                mediumMeteor[b]->explode();
-                                destroyedMeteorsCount++;
-
-                                for (int j = 0; j < 2; j++)
-                                {
-                                    if (smallMeteorsCount % 2 == 0)
-                                    {
-                                        smallMeteor[smallMeteorsCount]->setPosition(mediumMeteor[b]->getPosition());
-                                        smallMeteor[smallMeteorsCount]->setSpeedByAngle(shoot[i]->getRotation(), true);
-                                    }
-                                    else
-                                    {
-                                        smallMeteor[smallMeteorsCount]->setPosition(mediumMeteor[b]->getPosition());
-                                        smallMeteor[smallMeteorsCount]->setSpeedByAngle(shoot[i]->getRotation());
-                                    }
-
-                                    smallMeteor[smallMeteorsCount]->setActive(true);
-                                    smallMeteorsCount++;
-                                }
-
-                                b = maxMediumMeteors;
-                            }
-                        }
-
-                        for (int c = 0; c < maxSmallMeteors; c++)
-                        {
-                            if (smallMeteor[c]->getActive() && CheckCollisionCircles(shoot[i]->getPosition(), shoot[i]->getRadius(), smallMeteor[c]->getPosition(), smallMeteor[c]->getRadius()))
-                            {
-                                shoot[i]->setActive(false);
-                                shoot[i]->resetLifeSpawn();
-                                smallMeteor[c]->explode();
-                                destroyedMeteorsCount++;
-
-                                c = maxSmallMeteors;
-                            }
-                        }
-                    }
-                }
+                // The guest plays the level the host announced
+                if (coopSession != nullptr) level = simulation.getLevel();
             }
             else
             {
@@ -691,26 +830,32 @@ static void UpdateGame()
                 }
 
                 returnMenuButton->update();
-                if (returnMenuButton->isClick()) gameState = GameState::MainMenu;
+                if (returnMenuButton->isClick()) ReturnToMenu();
             }
 
-            if (destroyedMeteorsCount == maxBigMeteors + maxMediumMeteors + maxSmallMeteors) victory = true;
         }
         else 
         {
+            // Keeps answering, the other instance may still be missing the last inputs of this one
+            if (coopSession != nullptr) coopSession->poll(GetTime());
+
             reTryButton->update();
             returnMenuButton->update();
 
             if (reTryButton->isClick()) InitGame();
-            if (returnMenuButton->isClick()) gameState = GameState::MainMenu;
+            if (returnMenuButton->isClick()) ReturnToMenu();
         }
 
         break;
 
     case GameState::Tutorial:
 
-        if (!IsMusicPlaying(mainMusic)) PlayMusicStream(mainMusic);
-        else UpdateMusicStream(mainMusic);
+        {
+            PROFILE_SCOPE("Update/Music");
+
+            if (!IsMusicPlaying(mainMusic)) PlayMusicStream(mainMusic);
+            else UpdateMusicStream(mainMusic);
+        }
 
         tutorialButton->update();
         if (tutorialButton->isClick()) gameState = GameState::MainMenu;
@@ -719,8 +864,12 @@ static void UpdateGame()
 
     case GameState::Credits:
 
-        if (!IsMusicPlaying(mainMusic)) PlayMusicStream(mainMusic);
-        else UpdateMusicStream(mainMusic);
+        {
+            PROFILE_SCOPE("Update/Music");
+
+            if (!IsMusicPlaying(mainMusic)) PlayMusicStream(mainMusic);
+            else UpdateMusicStream(mainMusic);
+        }
 
         creditsButton->update();
         if (creditsButton->isClick()) gameState = GameState::MainMenu;
@@ -732,23 +881,39 @@ static void UpdateGame()
 // Draw game (one frame)
 static void DrawGame()
 {
+    PROFILE_SCOPE("DrawGame");
+
+    RenderQueue& renderQueue = RenderQueue::instance();
+    renderQueue.beginFrame();
+
     BeginDrawing();
 
     ClearBackground(BLACK);
 
 #pragma region Parallax Draw
+    {
+        PROFILE_SCOPE("Draw/Parallax");
 
-    DrawTextureEx(background, { scrollingBack, 20 }, 0.0f, 4.0f, WHITE);
-    DrawTextureEx(background, { background.width * 2 + scrollingBack, 20 }, 0.0f, 4.0f, WHITE);
-
-    DrawTextureEx(midground, { scrollingMid, 20 }, 0.0f, 4.0f, WHITE);
-    DrawTextureEx(midground, { midground.width * 2 + scrollingMid, 20 }, 0.0f, 4.0f, WHITE);
+        DrawTextureEx(background, { scrollingBack, 20 }, 0.0f, 4.0f, WHITE);
+        DrawTextureEx(background, { background.width * 2 + scrollingBack, 20 }, 0.0f, 4.0f, WHITE);
 
+        DrawTextureEx(midground, { scrollingMid, 20 }, 0.0f, 4.0f, WHITE);
+        DrawTextureEx(midground, { midground.width * 2 + scrollingMid, 20 }, 0.0f, 4.0f, WHITE);
+    }
 #pragma endregion
 
 
     switch (gameState)
     {
+    case GameState::Loading:
+
+        DrawText("Asteroid xD", (float)GetScreenWidth() / 2 - MeasureText("Asteroid xD", 80) / 2, (float)GetScreenHeight() * 0.15f, 80, WHITE);
+        DrawText(TextFormat("CARGANDO %i%%", (int)(loader.getProgress() * 100)), GetScreenWidth() / 2 - MeasureText("CARGANDO 100%", 20) / 2, GetScreenHeight() * 0.5f, 20, WHITE);
+
+        loadingBar->draw();
+
+        break;
+
     case GameState::MainMenu:
 
         DrawText("Asteroid xD", (float)GetScreenWidth() / 2 - MeasureText("Asteroid xD", 80) / 2, (float)GetScreenHeight() * 0.15f, 80, WHITE);
@@ -772,46 +937,84 @@ static void DrawGame()
         break;
 
     case GameState::Gameplay:
-        if (!gameOver)
+        if (!IsMatchLost())
         {
-            player->draw();
+            {
+                PROFILE_SCOPE("Draw/Entities");
+
+                for (int i = 0; i < simulation.getPlayerCount(); i++)
+                {
+                    // In co-op a destroyed ship is gone until the match ends
+                    const ShipState& ship = simulation.getShip(i);
+                    if (ship.shield <= 0) continue;
+
+                    Ship* view = ShipView(i);
+                    view->sync(ship);
+                    view->setPosition(RenderPosition(ship.previousPosition, ship.position));
+                    view->draw();
+                }
 
-            hpPowerUp->draw();
+                const PowerUpState& powerUp = simulation.getPowerUp();
+                hpPowerUp->setState(powerUp);
+                hpPowerUp->setPosition(RenderPosition(powerUp.previousPosition, powerUp.position));
+                hpPowerUp->draw();
 
-            // Draw meteors
-            for (int i = 0; i < maxBigMeteors; i++)
-            {
-                bigMeteor[i]->draw();
-            }
+                // Draw meteors
+                const MeteorField& meteors = simulation.getMeteors();
 
-            for (int i = 0; i < maxMediumMeteors; i++)
-            {
-                mediumMeteor[i]->draw();
-            }
+                for (int i = 0; i < meteors.size(); i++)
+                {
+                    if (!meteors.active[i]) continue;
 
-            for (int i = 0; i < maxSmallMeteors; i++)
-            {
-                smallMeteor[i]->draw();
-            }
+                    meteorView->submit(RenderPosition(meteors.getPreviousPosition(i), meteors.getPosition(i)), meteors.rotation[i], meteors.radius[i]);
+                }
 
-            // Draw shoot
-            for (int i = 0; i < shipMaxShoots; i++)
-            {
-                shoot[i]->draw();
+                // Sprites go out before the shoots, which are plain circles on top
+                renderQueue.flush();
+
+                // Draw shoot
+                for (const ShootState& s : simulation.getShoots())
+                {
+                    Shoot* view = (s.owner == LocalPlayer() || partnerShootView == nullptr) ? shootView : partnerShootView;
+                    view->setState(s);
+                    view->setPosition(RenderPosition(s.previousPosition, s.position));
+                    view->draw();
+                }
             }
 
+            PROFILE_SCOPE("Draw/UI");
+
             // Shield Bar
-            shieldBar->setProgressValue((float)player->getShield() / shipMaxShield);
+            shieldBar->setProgressValue((float)simulation.getShip(LocalPlayer()).shield / simulation.getConfig().shipMaxShield);
             shieldBar->draw();
 
-            if (victory)
+            if (coopSession != nullptr)
+            {
+                const RollbackStats& coopStats = coopSession->getStats();
+
+                DrawText(TextFormat("RTT %i ms  demora %i (sugerida %i)  rollback %i (max %i)  resimulados %i/s  esperas %i",
+                    (int)(coopStats.roundTrip * 1000.0), coopSession->getInputDelay(), coopSession->getRecommendedDelay(),
+                    coopStats.lastRollbackDepth, coopStats.maxRollbackDepth, (int)coopStats.resimulatedPerSecond, (int)coopStats.stalls), 20, 30, 10, LIGHTGRAY);
+
+                if (coopSession->isWaiting())
+                {
+                    const char* waitingText = (coopPlayer == 0) ? "ESPERANDO AL JUGADOR 2" : "ESPERANDO AL JUGADOR 1";
+                    DrawText(waitingText, screenWidth / 2 - MeasureText(waitingText, 30) / 2, screenHeight * 0.25f, 30, GRAY);
+                }
+                else if (coopSession->getSilence(GetTime()) > coopSilenceWarning)
+                {
+                    DrawText("SIN CONEXION CON EL OTRO JUGADOR", screenWidth / 2 - MeasureText("SIN CONEXION CON EL OTRO JUGADOR", 30) / 2, screenHeight * 0.25f, 30, GRAY);
+                }
+            }
+
+            if (IsLevelCleared())
             {
                 DrawText(TextFormat("NIVEL %0i COMPLETADO", level), screenWidth / 2 - MeasureText(TextFormat("NIVEL %0i COMPLETADO", level), 40) / 2, screenHeight * 0.25f, 40, LIGHTGRAY);
                 reTryButton->setText("SIGUIENTE NIVEL");
                 reTryButton->draw();
                 returnMenuButton->draw();
             }
-            else
+            else if (coopSession == nullptr)
             {
                 pauseButton->draw();
 
@@ -862,35 +1065,41 @@ static void DrawGame()
 
     //Mouse position
 #pragma region Mouse Crosshair Draw
-    
-    crosshair1Rot += GetFrameTime() * 90;
-    crosshair2Rot -= GetFrameTime() * 45;
-
-    // Crosshair 1
-    DrawTexturePro(
-        crosshair1,
-        Rectangle{ 0,0,(float)crosshair1.width,(float)crosshair1.height },
-        Rectangle{ (float)GetMouseX(), (float)GetMouseY(), (float)crosshair1.width * 0.5f,(float)crosshair1.height * 0.5f },
-        Vector2{ ((float)crosshair1.width * 0.5f) / 2, ((float)crosshair1.height * 0.5f) / 2 },
-        crosshair1Rot,
-        GREEN);
-
-    // Crosshair 2
-    DrawTexturePro(
-        crosshair2,
-        Rectangle{ 0,0,(float)crosshair2.width,(float)crosshair2.height },
-        Rectangle{ (float)GetMouseX(), (float)GetMouseY(), (float)crosshair2.width * 0.3f,(float)crosshair2.height * 0.3f },
-        Vector2{ ((float)crosshair2.width * 0.3f) / 2, ((float)crosshair2.height * 0.3f) / 2 },
-        crosshair2Rot,
-        LIME);
+    {
+        PROFILE_SCOPE("Draw/Crosshair");
+
+        crosshair1Rot += GetFrameTime() * 90;
+        crosshair2Rot -= GetFrameTime() * 45;
+
+        const Vector2 mouse = { (float)GetMouseX(), (float)GetMouseY() };
+
+        // Crosshair 1
+        renderQueue.submit(crosshair1, mouse, Vector2{ crosshair1.source.width * 0.5f, crosshair1.source.height * 0.5f }, crosshair1Rot, GREEN, RenderLayer::Cursor);
+
+        // Crosshair 2
+        renderQueue.submit(crosshair2, mouse, Vector2{ crosshair2.source.width * 0.3f, crosshair2.source.height * 0.3f }, crosshair2Rot, LIME, RenderLayer::Cursor);
+
+        renderQueue.flush();
     
 #if _DEBUG
-    DrawCircle(GetMouseX(), GetMouseY(), 5, RED);
-#endif
+        DrawCircle(GetMouseX(), GetMouseY(), 5, RED);
 
-#pragma endregion
+        const AssetCacheStats& cacheStats = AssetCache::instance().getStats();
+        DrawText(TextFormat("Assets hits %i misses %i resident %i (%i KB, peak %i KB)", cacheStats.hits, cacheStats.misses,
+            AssetCache::instance().getResidentCount(), (int)(cacheStats.residentBytes / 1024), (int)(cacheStats.peakResidentBytes / 1024)), 10, GetScreenHeight() - 40, 10, WHITE);
 
+        const RenderStats& renderStats = renderQueue.getStats();
+        DrawText(TextFormat("Sprites %i batches %i flushes %i", renderStats.quads, renderStats.batches, renderStats.flushes), 10, GetScreenHeight() - 55, 10, WHITE);
 
+        const VoicePool& voicePool = VoicePool::instance();
+        const VoiceStats& voiceStats = voicePool.getStats();
+        DrawText(TextFormat("Voices %i/%i played %i merged %i stolen %i dropped %i", voicePool.getPlayingCount(), voicePool.getVoiceLimit(),
+            voiceStats.played, voiceStats.merged, voiceStats.stolen, voiceStats.dropped), 10, GetScreenHeight() - 70, 10, WHITE);
+#endif
+    }
+#pragma endregion
+
+    PROFILE_SCOPE("Draw/EndDrawing");
     EndDrawing();
 }
 
@@ -898,69 +1107,108 @@ static void DrawGame()
 static void UpdateDrawGameFrame()
 {
     UpdateGame();
+
+    {
+        PROFILE_SCOPE("Update/Voices");
+        VoicePool::instance().update();
+    }
+
     DrawGame();
+
+    PROFILE_FRAME();
 }
 
-// Unload game variables
-static void UnloadGame()
+#ifdef ASTEROIDXD_PROFILE
+// Write the last frames of the profiler next to the executable and log a summary per phase
+static void SaveProfile()
 {
-    // Delete Player
-    delete player;
+    const Profiler& profiler = Profiler::instance();
 
-    delete hpPowerUp;
+    if (!profiler.dumpCsv("profile.csv")) TraceLog(LOG_WARNING, "PROFILER: Failed to write profile.csv");
+    if (!profiler.dumpChromeTrace("profile.json")) TraceLog(LOG_WARNING, "PROFILER: Failed to write profile.json");
 
-    // Delete Shoots
-    for (Shoot* s : shoot)
-    {
-        delete s;
-    }
-    shoot.clear();
+    TraceLog(LOG_INFO, "PROFILER: %-20s %8s %9s %9s %9s", "phase", "samples", "min ms", "avg ms", "p99 ms");
 
-    // Delete Meteors
-    for (Meteor* m : bigMeteor)
+    for (const ProfileSummary& phase : profiler.summarize())
     {
-        delete m;
+        TraceLog(LOG_INFO, "PROFILER: %-20s %8i %9.3f %9.3f %9.3f", phase.name.c_str(), phase.count, phase.min, phase.avg, phase.p99);
     }
-    bigMeteor.clear();
+}
+#endif
 
-    for (Meteor* m : mediumMeteor)
-    {
-        delete m;
-    }
-    mediumMeteor.clear();
+// Unload game variables
+static void UnloadGame()
+{
+    SaveRecording();
 
-    for (Meteor* m : smallMeteor)
-    {
-        delete m;
-    }
-    smallMeteor.clear();
+#ifdef ASTEROIDXD_PROFILE
+    SaveProfile();
+#endif
+
+    // Delete Player
+    delete player;
+    delete partner;
+
+    delete hpPowerUp;
+
+    delete shootView;
+    delete partnerShootView;
+    delete meteorView;
 
     // Delete UI
     delete playButton;
     delete tutorialButton;
     delete creditsButton;
     delete quitButton;
+    delete pauseButton;
     delete shieldBar;
     delete reTryButton;
     delete returnMenuButton;
 
     UnloadImage(gameIcon);
 
-    UnloadMusicStream(mainMusic);
-    UnloadMusicStream(gameplayMusic);
-    UnloadSound(laserSfx);
+    delete loadingBar;
+
+    levelAssets.release();
+    globalAssets.release();
+    VoicePool::instance().release();
+    loader.release();
+
+    // Every view and scope is gone, anything still resident was never released
+    AssetCache& cache = AssetCache::instance();
+
+    if (cache.getResidentCount() > 0) cache.logResident(LOG_WARNING, "Leaked at shutdown");
+    else TraceLog(LOG_INFO, "ASSETS: No leaks, peak resident %i KB", (int)(cache.getStats().peakResidentBytes / 1024));
+
     CloseAudioDevice();
 }
 
-void Run()
+void Run(bool record)
 {
+    recordInputs = record;
+
     // Initialization (Note windowTitle is unused on Android)
     //---------------------------------------------------------
     InitWindow(screenWidth, screenHeight, "Asteroid xD");
     gameIcon = LoadImage(gameIconUrl);
     SetWindowIcon(gameIcon);
 
-    InitGame();
+    InitAudioDevice();
+
+    if (archive.open(archiveUrl))
+    {
+        TraceLog(LOG_INFO, "ARCHIVE: %s mapped, %i entries", archiveUrl, archive.getEntryCount());
+        loader.setArchive(&archive);
+    }
+    else TraceLog(LOG_INFO, "ARCHIVE: %s not available, loading loose files", archiveUrl);
+
+    // InitGame runs once the loader finishes, the loading screen draws meanwhile
+    QueueAssets();
+    loader.start();
+
+    loadingBar = new ProgressBar(Vector2{ (float)GetScreenWidth() * 0.5f, (float)GetScreenHeight() * 0.6f }, 400, 12);
+    loadingBar->setPivot({ 0.5f, 0.5f });
+    loadingBar->setProgressValue(0);
 
     SetTargetFPS(60);
     //--------------------------------------------------------------------------------------
@@ -981,3 +1229,29 @@ void Run()
     CloseWindow();        // Close window and OpenGL context
     //--------------------------------------------------------------------------------------
 }
+
+int RunCoop(int localPlayer, const NetConditions& conditions)
+{
+    if (!coopTransport.open(coopPorts[localPlayer], "127.0.0.1", coopPorts[1 - localPlayer]))
+    {
+        TraceLog(LOG_ERROR, "COOP: Could not open udp port %i", coopPorts[localPlayer]);
+        return 1;
+    }
+
+    coopTransport.setConditions(conditions, (uint64_t)time(nullptr));
+
+    RollbackSettings settings;
+    settings.step = simulationStep;
+
+    coopPlayer = localPlayer;
+    coopSession = new RollbackSession(simulation, coopTransport, localPlayer, settings);
+
+    Run(false);
+
+    delete coopSession;
+    coopSession = nullptr;
+    coopPlayer = -1;
+    coopTransport.close();
+
+    return 0;
+}
@@ -1,10 +1,21 @@
 #pragma once
+#include "Net/Transport.h"
 
 #pragma region FUNCTIONS
 
 /// <summary>
 /// Ejecuta el juego
 /// </summary>
-void Run();
+/// <param name="recordInputs">Guarda el input de cada partida para reproducirla con --replay</param>
+void Run(bool recordInputs = false);
+
+/// <summary>
+/// Ejecuta el juego en cooperativo contra otra instancia en esta maquina, por UDP en 127.0.0.1.
+/// El jugador 0 es el anfitrion y elige nivel y semilla, el 1 se une a sus partidas.
+/// </summary>
+/// <param name="localPlayer">0 o 1</param>
+/// <param name="conditions">Latencia y perdida agregadas a lo que envia esta instancia, para probar</param>
+/// <returns>Codigo de salida del proceso, distinto de 0 si el puerto esta ocupado</returns>
+int RunCoop(int localPlayer, const NetConditions& conditions);
 
 #pragma endregion
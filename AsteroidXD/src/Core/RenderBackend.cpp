@@ -0,0 +1,59 @@
+#include "RenderBackend.h"
+
+static RaylibBackend raylibBackend;
+static RenderBackend* currentBackend = &raylibBackend;
+
+RenderBackend& RenderBackend::current()
+{
+    return *currentBackend;
+}
+
+void RenderBackend::setCurrent(RenderBackend* backend)
+{
+    currentBackend = (backend != nullptr) ? backend : &raylibBackend;
+}
+
+Texture2D RaylibBackend::loadTexture(Image image)
+{
+    return LoadTextureFromImage(image);
+}
+
+void RaylibBackend::unloadTexture(Texture2D texture)
+{
+    UnloadTexture(texture);
+}
+
+void RaylibBackend::drawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint)
+{
+    DrawTexturePro(texture, source, dest, origin, rotation, tint);
+}
+
+void RaylibBackend::drawCircle(Vector2 center, float radius, Color color)
+{
+    DrawCircleV(center, radius, color);
+}
+
+void RaylibBackend::drawLine(Vector2 start, Vector2 end, Color color)
+{
+    DrawLineV(start, end, color);
+}
+
+void RaylibBackend::drawRectangleRounded(Rectangle rec, float roundness, int segments, Color color)
+{
+    DrawRectangleRounded(rec, roundness, segments, color);
+}
+
+void RaylibBackend::drawRectangleRoundedLines(Rectangle rec, float roundness, int segments, int lineThick, Color color)
+{
+    DrawRectangleRoundedLines(rec, roundness, segments, lineThick, color);
+}
+
+void RaylibBackend::drawText(const char text[], int posX, int posY, int fontSize, Color color)
+{
+    DrawText(text, posX, posY, fontSize, color);
+}
+
+int RaylibBackend::measureText(const char text[], int fontSize)
+{
+    return MeasureText(text, fontSize);
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "raylib.h"
+
+/// <summary>
+/// Primitivas que usan las vistas para dibujar (sprites, circulos, rectangulos redondeados y texto).
+/// Por defecto van directo a raylib; con otra implementacion (SoftwareRenderer) se puede dibujar sin GPU.
+/// Las texturas tambien se crean por aca, asi el id solo tiene sentido para el backend que lo creo.
+/// </summary>
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    /// <summary>
+    /// Backend en uso, raylib si nadie puso otro
+    /// </summary>
+    /// <returns></returns>
+    static RenderBackend& current();
+
+    /// <summary>
+    /// Cambia el backend, nullptr vuelve a raylib. Las texturas cargadas con el anterior dejan de ser validas
+    /// </summary>
+    /// <param name="backend"></param>
+    static void setCurrent(RenderBackend* backend);
+
+    /// <summary>
+    /// Crea una textura con los pixeles de la imagen, la imagen sigue siendo de quien llama
+    /// </summary>
+    /// <param name="image"></param>
+    /// <returns></returns>
+    virtual Texture2D loadTexture(Image image) = 0;
+    virtual void unloadTexture(Texture2D texture) = 0;
+
+    // Same parameters as the raylib function of the same name
+    virtual void drawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) = 0;
+    virtual void drawCircle(Vector2 center, float radius, Color color) = 0;
+    virtual void drawLine(Vector2 start, Vector2 end, Color color) = 0;
+    virtual void drawRectangleRounded(Rectangle rec, float roundness, int segments, Color color) = 0;
+    virtual void drawRectangleRoundedLines(Rectangle rec, float roundness, int segments, int lineThick, Color color) = 0;
+    virtual void drawText(const char text[], int posX, int posY, int fontSize, Color color) = 0;
+    virtual int measureText(const char text[], int fontSize) = 0;
+};
+
+/// <summary>
+/// Backend por defecto, cada llamada es la funcion de raylib
+/// </summary>
+class RaylibBackend : public RenderBackend
+{
+public:
+    Texture2D loadTexture(Image image) override;
+    void unloadTexture(Texture2D texture) override;
+
+    void drawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) override;
+    void drawCircle(Vector2 center, float radius, Color color) override;
+    void drawLine(Vector2 start, Vector2 end, Color color) override;
+    void drawRectangleRounded(Rectangle rec, float roundness, int segments, Color color) override;
+    void drawRectangleRoundedLines(Rectangle rec, float roundness, int segments, int lineThick, Color color) override;
+    void drawText(const char text[], int posX, int posY, int fontSize, Color color) override;
+    int measureText(const char text[], int fontSize) override;
+};
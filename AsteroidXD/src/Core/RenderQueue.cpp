@@ -0,0 +1,68 @@
+#include "RenderQueue.h"
+#include "RenderBackend.h"
+#include <algorithm>
+
+RenderQueue& RenderQueue::instance()
+{
+    static RenderQueue queue;
+    return queue;
+}
+
+void RenderQueue::submit(const Sprite& sprite, Vector2 position, Vector2 size, float rotation, Color tint, RenderLayer layer)
+{
+    const uint64_t key = ((uint64_t)layer << 56) | ((uint64_t)(sprite.texture.id & 0xFFFFFF) << 32) | (uint64_t)instances.size();
+
+    keys.push_back(SortKey{ key, (int)instances.size() });
+    instances.push_back(SpriteInstance
+    {
+        sprite.texture,
+        sprite.source,
+        Rectangle{ position.x, position.y, size.x, size.y },
+        Vector2{ size.x * 0.5f, size.y * 0.5f },
+        rotation,
+        tint
+    });
+}
+
+void RenderQueue::flush()
+{
+    if (instances.empty()) return;
+
+    auto byKey = [](const SortKey& a, const SortKey& b) { return a.key < b.key; };
+
+    // Usually everything comes from the atlas in layer order, then there is nothing to sort
+    if (!std::is_sorted(keys.begin(), keys.end(), byKey)) std::sort(keys.begin(), keys.end(), byKey);
+
+    RenderBackend& backend = RenderBackend::current();
+    unsigned int texture = instances[keys.front().instance].texture.id;
+    stats.batches++;
+
+    for (const SortKey& key : keys)
+    {
+        const SpriteInstance& sprite = instances[key.instance];
+
+        if (sprite.texture.id != texture)
+        {
+            texture = sprite.texture.id;
+            stats.batches++;
+        }
+
+        backend.drawTexturePro(sprite.texture, sprite.source, sprite.dest, sprite.origin, sprite.rotation, sprite.tint);
+    }
+
+    stats.quads += (int)instances.size();
+    stats.flushes++;
+
+    instances.clear();
+    keys.clear();
+}
+
+void RenderQueue::beginFrame()
+{
+    stats = RenderStats();
+}
+
+const RenderStats& RenderQueue::getStats() const
+{
+    return stats;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "raylib.h"
+#include "AssetCache.h"
+
+/// <summary>
+/// Capas de dibujo, de atras hacia adelante (el mismo orden en que se dibujaban las entidades)
+/// </summary>
+enum class RenderLayer : unsigned char
+{
+    Ship,
+    PowerUp,
+    Meteors,
+    Cursor
+};
+
+/// <summary>
+/// Contadores del frame: quads enviados, tandas de la misma textura y flushes
+/// </summary>
+struct RenderStats
+{
+    int quads = 0;
+    int batches = 0;
+    int flushes = 0;
+};
+
+/// <summary>
+/// Cola de sprites: las entidades envian instancias (textura, region, transformacion, color y capa)
+/// y flush() las dibuja ordenadas por capa y textura, asi cada tanda usa una sola textura.
+/// Dentro de una capa y textura se respeta el orden de envio.
+/// </summary>
+class RenderQueue
+{
+private:
+    struct SpriteInstance
+    {
+        Texture2D texture;
+        Rectangle source;
+        Rectangle dest;
+        Vector2 origin;
+        float rotation;
+        Color tint;
+    };
+
+    // layer (8 bits) | texture id (24 bits) | submission order (32 bits)
+    struct SortKey
+    {
+        uint64_t key;
+        int instance;
+    };
+
+    std::vector<SpriteInstance> instances;
+    std::vector<SortKey> keys;
+    RenderStats stats;
+
+private:
+    RenderQueue() = default;
+
+public:
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+
+    static RenderQueue& instance();
+
+    /// <summary>
+    /// Encola un sprite centrado en position, size es el tamaño en pantalla
+    /// </summary>
+    /// <param name="sprite"></param>
+    /// <param name="position"></param>
+    /// <param name="size"></param>
+    /// <param name="rotation"></param>
+    /// <param name="tint"></param>
+    /// <param name="layer"></param>
+    void submit(const Sprite& sprite, Vector2 position, Vector2 size, float rotation, Color tint, RenderLayer layer);
+
+    /// <summary>
+    /// Dibuja todo lo encolado y vacia la cola
+    /// </summary>
+    void flush();
+
+    /// <summary>
+    /// Reinicia los contadores, una vez por frame
+    /// </summary>
+    void beginFrame();
+
+    const RenderStats& getStats() const;
+};
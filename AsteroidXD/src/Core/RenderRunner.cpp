@@ -0,0 +1,193 @@
+#include "RenderRunner.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include "raylib.h"
+#include "AssetLoader.h"
+#include "AssetScope.h"
+#include "RenderQueue.h"
+#include "SoftwareRenderer.h"
+#include "VoicePool.h"
+#include "Simulation/Simulation.h"
+#include "Class/GameObjects/Ship.h"
+#include "Class/GameObjects/Meteor.h"
+#include "Class/GameObjects/HpPowerUp.h"
+#include "Class/GameObjects/Shoot.h"
+#include "Class/UIObjects/ProgressBar.h"
+#include "Class/UIObjects/Button.h"
+
+// Same files the game draws, sounds stay out because there is no audio device
+static const char shipImgUrl[] = "resources/images/ship_G.png";
+static const char meteorImgUrl[] = "resources/images/meteor_detailedLarge.png";
+static const char hpSpriteUrl[] = "resources/images/icon_plusSmall.png";
+static const char backgroundUrl[] = "resources/images/parallax-space-far-planets.png";
+static const char midgroundUrl[] = "resources/images/parallax-space-stars.png";
+
+static const int screenWidth = 1024;
+static const int screenHeight = 720;
+static const uint64_t renderSeed = 20210601;
+
+// Two ticks per frame, like the game at 60 fps with its 120 Hz simulation
+static const float simulationStep = 1.0f / 120.0f;
+static const int ticksPerFrame = 2;
+
+// Always the same input for a tick: the aim goes around the centre, fires every quarter second and thrusts in bursts
+static SimInput ScriptedInput(unsigned long long tick)
+{
+    const float angle = tick * 0.01f;
+
+    SimInput input;
+    input.aim = Vector2{ screenWidth * 0.5f + cosf(angle) * 200.0f, screenHeight * 0.5f + sinf(angle) * 200.0f };
+    input.thrust = (tick / 120) % 3 == 0;
+    input.fire = tick % 30 == 0;
+
+    return input;
+}
+
+// DrawTextureEx with scale 4, the way the game draws the parallax layers
+static void DrawParallaxLayer(RenderBackend& backend, Texture2D texture, float x)
+{
+    backend.drawTexturePro(
+        texture,
+        Rectangle{ 0, 0, (float)texture.width, (float)texture.height },
+        Rectangle{ x, 20, texture.width * 4.0f, texture.height * 4.0f },
+        Vector2{ 0, 0 },
+        0.0f,
+        WHITE);
+}
+
+int RunRenderTest(int frames, const char prefix[])
+{
+    typedef std::chrono::steady_clock Clock;
+
+    SoftwareRenderer renderer(screenWidth, screenHeight);
+    RenderBackend::setCurrent(&renderer);
+
+    // Textures are created through the backend, so everything loads after it is set
+    AssetLoader loader;
+    loader.queueSprite(shipImgUrl);
+    loader.queueSprite(meteorImgUrl);
+    loader.queueSprite(hpSpriteUrl);
+    loader.queueTexture(backgroundUrl);
+    loader.queueTexture(midgroundUrl);
+    loader.start();
+
+    while (!loader.isDone())
+    {
+        if (loader.finalize(1.0) == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    if (loader.getFailedCount() > 0)
+    {
+        printf("%i assets could not be loaded, run from the folder with resources\n", loader.getFailedCount());
+        loader.release();
+        RenderBackend::setCurrent(nullptr);
+        return 1;
+    }
+
+    AssetScope assets("render");
+    Texture2D background = assets.loadTexture(backgroundUrl);
+    Texture2D midground = assets.loadTexture(midgroundUrl);
+
+    Ship* player = new Ship(Vector2{ 0, 0 }, shipImgUrl, "", "", "");
+    Meteor* meteorView = new Meteor(meteorImgUrl, "");
+    HpPowerUp* hpPowerUp = new HpPowerUp(hpSpriteUrl, "");
+    Shoot* shootView = new Shoot(WHITE);
+    ProgressBar* shieldBar = new ProgressBar(Vector2{ 20,10 }, 300, 10, 1, 12, 2);
+    Button* pauseButton = new Button(Vector2{ (float)screenWidth - 20, 10 }, " || ", "", 20, 5, 1, 0.5f, 16, 3, WHITE, RED, MAROON);
+    pauseButton->setPivot({ 1,0 });
+
+    loader.release();
+
+    Simulation simulation;
+    simulation.reset(1, renderSeed);
+
+    RenderQueue& renderQueue = RenderQueue::instance();
+    float scrollingBack = 0.0f;
+    float scrollingMid = 0.0f;
+    double totalMs = 0.0;
+    int exitCode = 0;
+
+    printf("%6s %8s %8s %8s %10s %18s\n", "frame", "tick", "sprites", "batches", "draw ms", "hash");
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        for (int t = 0; t < ticksPerFrame && !simulation.isGameOver(); t++)
+        {
+            simulation.step(ScriptedInput(simulation.getTick()), simulationStep);
+        }
+
+        scrollingBack -= 6.0f * simulationStep * ticksPerFrame;
+        scrollingMid -= 30.0f * simulationStep * ticksPerFrame;
+
+        if (scrollingBack <= -background.width * 2) scrollingBack = 0;
+        if (scrollingMid <= -midground.width * 2) scrollingMid = 0;
+
+        Clock::time_point start = Clock::now();
+
+        renderQueue.beginFrame();
+        renderer.clear(BLACK);
+
+        DrawParallaxLayer(renderer, background, scrollingBack);
+        DrawParallaxLayer(renderer, background, background.width * 2 + scrollingBack);
+        DrawParallaxLayer(renderer, midground, scrollingMid);
+        DrawParallaxLayer(renderer, midground, midground.width * 2 + scrollingMid);
+
+        const ShipState& ship = simulation.getShip();
+        player->sync(ship);
+        player->draw();
+
+        hpPowerUp->setState(simulation.getPowerUp());
+        hpPowerUp->draw();
+
+        const MeteorField& meteors = simulation.getMeteors();
+
+        for (int i = 0; i < meteors.size(); i++)
+        {
+            if (meteors.active[i]) meteorView->submit(meteors.getPosition(i), meteors.rotation[i], meteors.radius[i]);
+        }
+
+        renderQueue.flush();
+
+        for (const ShootState& s : simulation.getShoots())
+        {
+            shootView->setState(s);
+            shootView->draw();
+        }
+
+        shieldBar->setProgressValue((float)ship.shield / simulation.getConfig().shipMaxShield);
+        shieldBar->draw();
+        pauseButton->draw();
+
+        double drawMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        totalMs += drawMs;
+
+        const RenderStats& stats = renderQueue.getStats();
+
+        printf("%6i %8llu %8i %8i %10.3f %018llx\n", frame, simulation.getTick(), stats.quads, stats.batches, drawMs, (unsigned long long)renderer.hash());
+
+        if (prefix != nullptr && !renderer.savePpm(TextFormat("%s_%03i.ppm", prefix, frame)))
+        {
+            printf("could not write %s_%03i.ppm\n", prefix, frame);
+            exitCode = 1;
+            break;
+        }
+    }
+
+    if (frames > 0) printf("average %.3f ms per frame\n", totalMs / frames);
+
+    // Everything goes back to the renderer that created it
+    delete player;
+    delete meteorView;
+    delete hpPowerUp;
+    delete shootView;
+    delete shieldBar;
+    delete pauseButton;
+    assets.release();
+    VoicePool::instance().release();
+
+    RenderBackend::setCurrent(nullptr);
+
+    return exitCode;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#pragma region FUNCTIONS
+
+/// <summary>
+/// Dibuja una partida scripteada sin ventana ni GPU con SoftwareRenderer
+/// e informa por frame los sprites, los lotes, el tiempo de dibujo y el hash de la imagen.
+/// Con el mismo ejecutable los hashes se repiten, asi sirve de prueba de regresion visual.
+/// </summary>
+/// <param name="frames">Cantidad de frames a dibujar</param>
+/// <param name="prefix">Si no es nullptr guarda cada frame como prefix_NNN.ppm</param>
+/// <returns>Codigo de salida del proceso, distinto de 0 si faltan assets</returns>
+int RunRenderTest(int frames, const char prefix[]);
+
+#pragma endregion
@@ -0,0 +1,69 @@
+#include "ReplayRunner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "Simulation/Simulation.h"
+#include "Simulation/InputRecording.h"
+
+static double Percentile(const std::vector<double>& sorted, double percent)
+{
+    if (sorted.empty()) return 0.0;
+
+    size_t index = (size_t)(percent / 100.0 * (double)(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+int RunReplays(int fileCount, char* files[])
+{
+    typedef std::chrono::steady_clock Clock;
+
+    int exitCode = 0;
+    InputRecording recording;
+    std::vector<double> tickTimes;
+
+    printf("%-32s %8s %10s %10s %10s %10s %10s %s\n", "replay", "ticks", "total ms", "p50 us", "p90 us", "p99 us", "max us", "result");
+
+    for (int f = 0; f < fileCount; f++)
+    {
+        if (!recording.load(files[f]))
+        {
+            printf("%-32s could not be read\n", files[f]);
+            exitCode = 1;
+            continue;
+        }
+
+        Simulation simulation(recording.getConfig());
+        simulation.reset(recording.level, recording.seed);
+
+        tickTimes.clear();
+        tickTimes.reserve(recording.inputs.size());
+
+        Clock::time_point start = Clock::now();
+
+        for (const SimInput& input : recording.inputs)
+        {
+            Clock::time_point tickStart = Clock::now();
+            simulation.step(input, recording.step);
+            tickTimes.push_back(std::chrono::duration<double, std::micro>(Clock::now() - tickStart).count());
+        }
+
+        double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        std::sort(tickTimes.begin(), tickTimes.end());
+
+        const char* result = simulation.isGameOver() ? "game over" : (simulation.isVictory() ? "victory" : "unfinished");
+
+        printf("%-32s %8zu %10.3f %10.3f %10.3f %10.3f %10.3f %s\n",
+            files[f],
+            recording.inputs.size(),
+            totalMs,
+            Percentile(tickTimes, 50),
+            Percentile(tickTimes, 90),
+            Percentile(tickTimes, 99),
+            tickTimes.empty() ? 0.0 : tickTimes.back(),
+            result);
+    }
+
+    return exitCode;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#pragma region FUNCTIONS
+
+/// <summary>
+/// Reproduce grabaciones de partidas sin ventana, lo mas rapido posible,
+/// e informa el tiempo total de simulacion y los percentiles por tick de cada archivo
+/// </summary>
+/// <param name="fileCount"></param>
+/// <param name="files"></param>
+/// <returns>Codigo de salida del proceso, distinto de 0 si algun archivo no se pudo leer</returns>
+int RunReplays(int fileCount, char* files[]);
+
+#pragma endregion
@@ -0,0 +1,207 @@
+#include "ServerRunner.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "Net/LoopbackTransport.h"
+#include "Net/MatchServer.h"
+#include "Net/StateClient.h"
+#include "Utils/JobSystem.h"
+
+static const uint64_t serverSeed = 20210701;
+
+struct TestClient
+{
+    std::unique_ptr<LoopbackTransport> serverEnd;
+    std::unique_ptr<LoopbackTransport> clientEnd;
+    std::unique_ptr<StateClient> client;
+    int match;
+    int player;
+    int32_t lastChecked;
+};
+
+// A bot that only knows what the server sent: aims at the nearest meteor, thrusts in bursts and fires every quarter second
+static SimInput BotInput(const StateClient& client, int player, int tick)
+{
+    SimInput input;
+    input.aim = Vector2{ 512.0f, 360.0f };
+    input.thrust = ((tick + player * 90) / 120) % 3 == 0;
+    input.fire = (tick + player * 15) % 30 == 0;
+
+    if (!client.hasFrame()) return input;
+
+    const NetFrame& frame = client.getFrame();
+    const StateCodec& codec = client.getCodec();
+
+    if (player >= (int)frame.ships.size()) return input;
+
+    const Vector2 ship = codec.toPosition(frame.ships[player].x, frame.ships[player].y);
+    float nearest = -1.0f;
+
+    for (const NetMeteor& meteor : frame.meteors)
+    {
+        if (!meteor.active) continue;
+
+        const Vector2 position = codec.toPosition(meteor.x, meteor.y);
+        const float distance = Vector2Distance(ship, position);
+
+        if (nearest < 0.0f || distance < nearest)
+        {
+            nearest = distance;
+            input.aim = position;
+        }
+    }
+
+    return input;
+}
+
+static bool SameFrame(const NetFrame& a, const NetFrame& b)
+{
+    return a.tick == b.tick && a.level == b.level && a.gameOver == b.gameOver && a.victory == b.victory
+        && a.ships == b.ships && a.powerUp == b.powerUp && a.meteors == b.meteors && a.shoots == b.shoots;
+}
+
+int RunServerTest(int matches, int ticks, const NetConditions& conditions)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    SimConfig config;
+    config.players = 2;
+
+    ServerSettings settings;
+    MatchServer server(config, settings);
+    std::vector<TestClient> clients;
+
+    for (int m = 0; m < matches; m++)
+    {
+        server.addMatch(serverSeed + (uint64_t)m * 7919);
+
+        for (int player = 0; player < config.players; player++)
+        {
+            TestClient test;
+            test.serverEnd.reset(new LoopbackTransport());
+            test.clientEnd.reset(new LoopbackTransport());
+            LoopbackTransport::connect(*test.serverEnd, *test.clientEnd);
+
+            // Each direction loses its own datagrams
+            test.serverEnd->setConditions(conditions, clients.size() * 2 + 1);
+            test.clientEnd->setConditions(conditions, clients.size() * 2 + 2);
+
+            test.client.reset(new StateClient(config, *test.clientEnd, settings.step));
+            test.match = m;
+            test.player = player;
+            test.lastChecked = -1;
+
+            server.addClient(m, player, *test.serverEnd);
+            clients.push_back(std::move(test));
+        }
+    }
+
+    const int threads = JobSystem::instance().getWorkerCount() + 1;
+
+    printf("server %i matches x %i players, %i ticks at %.0f Hz, state every %i ticks, latency %.0f ms, jitter %.0f ms, loss %.0f%%, %i threads\n",
+        matches, config.players, ticks, 1.0f / settings.step, settings.sendInterval,
+        conditions.latency * 1000.0, conditions.jitter * 1000.0, conditions.loss * 100.0f, threads);
+
+    unsigned long long checked = 0;
+    unsigned long long mismatches = 0;
+    double serverSeconds = 0.0;
+    double clientSeconds = 0.0;
+
+    for (int tick = 0; tick < ticks; tick++)
+    {
+        const double now = tick * (double)settings.step;
+
+        Clock::time_point start = Clock::now();
+
+        for (TestClient& test : clients)
+        {
+            test.client->update(BotInput(*test.client, test.player, tick), now);
+        }
+
+        Clock::time_point clientsDone = Clock::now();
+        server.update(now);
+
+        serverSeconds += std::chrono::duration<double>(Clock::now() - clientsDone).count();
+        clientSeconds += std::chrono::duration<double>(clientsDone - start).count();
+
+        // Every new frame a client built has to be the one the server quantized
+        for (TestClient& test : clients)
+        {
+            if (!test.client->hasFrame()) continue;
+
+            const NetFrame& frame = test.client->getFrame();
+            if (frame.tick == test.lastChecked) continue;
+
+            test.lastChecked = frame.tick;
+
+            const NetFrame* sent = server.getFrame(test.match, frame.tick);
+            if (sent == nullptr) continue;
+
+            checked++;
+            if (!SameFrame(frame, *sent)) mismatches++;
+        }
+    }
+
+    const ServerStats& stats = server.getStats();
+
+    if (stats.ticks == 0 || stats.matchTicks == 0)
+    {
+        printf("nothing ran\n");
+        return 1;
+    }
+
+    // What a frame would take without deltas, and the raw snapshot, for the same final states
+    EncodedFrame full;
+    const NetFrame empty{ };
+    unsigned long long fullReference = 0;
+    unsigned long long snapshotReference = 0;
+    int referenceFrames = 0;
+
+    for (int m = 0; m < matches; m++)
+    {
+        snapshotReference += server.getSimulation(m).getSnapshotSize();
+
+        for (int32_t t = server.getTick() - 1; t >= 0 && t >= server.getTick() - settings.sendInterval; t--)
+        {
+            const NetFrame* frame = server.getFrame(m, t);
+            if (frame == nullptr || !server.getCodec().encode(*frame, empty, Transport::maxDatagramSize - stateFrameHeaderSize, full)) continue;
+
+            fullReference += full.bytes.size() + full.getPartCount() * stateFrameHeaderSize;
+            referenceFrames++;
+        }
+    }
+
+    const double cpuPerMatchTick = (stats.simulateSeconds + stats.encodeSeconds) / stats.matchTicks;
+    const double wallPerTick = serverSeconds / stats.ticks;
+    const double bytesPerTick = (double)stats.bytesSent / stats.ticks;
+    const int clientCount = (int)clients.size();
+
+    printf("cpu per match tick: simulate %.2f us, encode and send %.2f us, total %.2f us\n",
+        stats.simulateSeconds * 1e6 / stats.matchTicks, stats.encodeSeconds * 1e6 / stats.matchTicks, cpuPerMatchTick * 1e6);
+    printf("matches per core at %.0f Hz: %.0f\n", 1.0f / settings.step, settings.step / cpuPerMatchTick);
+    printf("wall per server tick: %.3f ms with %i threads, real time up to %.0f matches on this machine\n",
+        wallPerTick * 1000.0, threads, settings.step / wallPerTick * matches);
+    printf("bytes per tick: %.0f total, %.1f per match, %.1f per client (%.1f kbit/s per client)\n",
+        bytesPerTick, bytesPerTick / matches, bytesPerTick / clientCount, bytesPerTick / clientCount * 8.0 / settings.step / 1000.0);
+    printf("frames sent: %llu deltas of %.1f bytes, %llu full of %.1f bytes, %llu oversized, %llu packets\n",
+        stats.deltaFrames, stats.deltaFrames > 0 ? (double)stats.deltaBytes / stats.deltaFrames : 0.0,
+        stats.fullFrames, stats.fullFrames > 0 ? (double)stats.fullBytes / stats.fullFrames : 0.0,
+        stats.oversizedFrames, stats.packetsSent);
+    printf("same states without deltas: %.1f bytes per frame, raw snapshot %.1f bytes\n",
+        referenceFrames > 0 ? (double)fullReference / referenceFrames : 0.0, (double)snapshotReference / matches);
+
+    unsigned long long built = 0;
+    unsigned long long dropped = 0;
+
+    for (const TestClient& test : clients)
+    {
+        built += test.client->getStats().framesReceived;
+        dropped += test.client->getStats().framesDropped;
+    }
+
+    printf("clients: %llu frames built, %llu dropped, %llu checked against the server, %llu mismatches, %.2f us per client tick\n",
+        built, dropped, checked, mismatches, clientSeconds * 1e6 / ((double)ticks * clientCount));
+
+    return (mismatches > 0 || built == 0) ? 1 : 0;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "Net/Transport.h"
+
+#pragma region FUNCTIONS
+
+/// <summary>
+/// Corre un MatchServer con varias partidas de dos jugadores y sus clientes en el mismo proceso,
+/// unidos por transportes en memoria, con bots que juegan mirando solo el estado que les llega.
+/// Informa el costo de CPU por partida, cuantas partidas entran en un core a 120 Hz y los bytes por tick,
+/// y compara cada frame que arman los clientes con el que envio el servidor.
+/// </summary>
+/// <param name="matches">Partidas simultaneas</param>
+/// <param name="ticks">Ticks de servidor a correr</param>
+/// <param name="conditions">Latencia, jitter y perdida de cada direccion</param>
+/// <returns>Codigo de salida del proceso, distinto de 0 si un cliente arma un frame distinto</returns>
+int RunServerTest(int matches, int ticks, const NetConditions& conditions);
+
+#pragma endregion
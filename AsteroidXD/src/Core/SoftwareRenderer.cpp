@@ -0,0 +1,393 @@
+#include "SoftwareRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Same metrics as raylib's default font: base size 10, spacing fontSize / 10
+static const int fontBaseSize = 10;
+static const int glyphColumns = 5;
+static const int glyphAdvance = 6;
+
+// 5x7 glyphs for ' ' to '~', one byte per column, bit 0 is the top row
+static const unsigned char font5x7[95][glyphColumns] =
+{
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, { 0x00, 0x07, 0x00, 0x07, 0x00 }, { 0x14, 0x7F, 0x14, 0x7F, 0x14 },
+    { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 }, { 0x36, 0x49, 0x55, 0x22, 0x50 }, { 0x00, 0x05, 0x03, 0x00, 0x00 },
+    { 0x00, 0x1C, 0x22, 0x41, 0x00 }, { 0x00, 0x41, 0x22, 0x1C, 0x00 }, { 0x08, 0x2A, 0x1C, 0x2A, 0x08 }, { 0x08, 0x08, 0x3E, 0x08, 0x08 },
+    { 0x00, 0x50, 0x30, 0x00, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, { 0x00, 0x60, 0x60, 0x00, 0x00 }, { 0x20, 0x10, 0x08, 0x04, 0x02 },
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 }, { 0x42, 0x61, 0x51, 0x49, 0x46 }, { 0x21, 0x41, 0x45, 0x4B, 0x31 },
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, { 0x27, 0x45, 0x45, 0x45, 0x39 }, { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, { 0x01, 0x71, 0x09, 0x05, 0x03 },
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x06, 0x49, 0x49, 0x29, 0x1E }, { 0x00, 0x36, 0x36, 0x00, 0x00 }, { 0x00, 0x56, 0x36, 0x00, 0x00 },
+    { 0x08, 0x14, 0x22, 0x41, 0x00 }, { 0x14, 0x14, 0x14, 0x14, 0x14 }, { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x51, 0x09, 0x06 },
+    { 0x32, 0x49, 0x79, 0x41, 0x3E }, { 0x7E, 0x11, 0x11, 0x11, 0x7E }, { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 },
+    { 0x7F, 0x41, 0x41, 0x22, 0x1C }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, { 0x7F, 0x09, 0x09, 0x09, 0x01 }, { 0x3E, 0x41, 0x49, 0x49, 0x7A },
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 }, { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 },
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 }, { 0x7F, 0x02, 0x0C, 0x02, 0x7F }, { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E },
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, { 0x7F, 0x09, 0x19, 0x29, 0x46 }, { 0x46, 0x49, 0x49, 0x49, 0x31 },
+    { 0x01, 0x01, 0x7F, 0x01, 0x01 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F }, { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F },
+    { 0x63, 0x14, 0x08, 0x14, 0x63 }, { 0x07, 0x08, 0x70, 0x08, 0x07 }, { 0x61, 0x51, 0x49, 0x45, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x00 },
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x7F, 0x00 }, { 0x04, 0x02, 0x01, 0x02, 0x04 }, { 0x40, 0x40, 0x40, 0x40, 0x40 },
+    { 0x00, 0x01, 0x02, 0x04, 0x00 }, { 0x20, 0x54, 0x54, 0x54, 0x78 }, { 0x7F, 0x48, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x20 },
+    { 0x38, 0x44, 0x44, 0x48, 0x7F }, { 0x38, 0x54, 0x54, 0x54, 0x18 }, { 0x08, 0x7E, 0x09, 0x01, 0x02 }, { 0x0C, 0x52, 0x52, 0x52, 0x3E },
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, { 0x20, 0x40, 0x44, 0x3D, 0x00 }, { 0x7F, 0x10, 0x28, 0x44, 0x00 },
+    { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x18, 0x04, 0x78 }, { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 },
+    { 0x7C, 0x14, 0x14, 0x14, 0x08 }, { 0x08, 0x14, 0x14, 0x18, 0x7C }, { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x20 },
+    { 0x04, 0x3F, 0x44, 0x40, 0x20 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, { 0x1C, 0x20, 0x40, 0x20, 0x1C }, { 0x3C, 0x40, 0x30, 0x40, 0x3C },
+    { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x0C, 0x50, 0x50, 0x50, 0x3C }, { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 },
+    { 0x00, 0x00, 0x7F, 0x00, 0x00 }, { 0x00, 0x41, 0x36, 0x08, 0x00 }, { 0x08, 0x04, 0x08, 0x10, 0x08 }
+};
+
+SoftwareRenderer::SoftwareRenderer(int width, int height) :
+    width(width), height(height), pixels((size_t)width * height, BLACK) { }
+
+SoftwareRenderer::~SoftwareRenderer()
+{
+    for (Image& image : textures)
+    {
+        if (image.data != nullptr) UnloadImage(image);
+    }
+}
+
+void SoftwareRenderer::clear(Color color)
+{
+    std::fill(pixels.begin(), pixels.end(), color);
+}
+
+int SoftwareRenderer::getWidth() const
+{
+    return width;
+}
+
+int SoftwareRenderer::getHeight() const
+{
+    return height;
+}
+
+const std::vector<Color>& SoftwareRenderer::getPixels() const
+{
+    return pixels;
+}
+
+uint64_t SoftwareRenderer::hash() const
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    for (const Color& pixel : pixels)
+    {
+        hash = (hash ^ pixel.r) * 1099511628211ull;
+        hash = (hash ^ pixel.g) * 1099511628211ull;
+        hash = (hash ^ pixel.b) * 1099511628211ull;
+    }
+
+    return hash;
+}
+
+bool SoftwareRenderer::savePpm(const char fileName[]) const
+{
+    FILE* file = fopen(fileName, "wb");
+    if (file == nullptr) return false;
+
+    fprintf(file, "P6\n%i %i\n255\n", width, height);
+
+    std::vector<unsigned char> row((size_t)width * 3);
+
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            const Color& pixel = pixels[(size_t)y * width + x];
+            row[x * 3 + 0] = pixel.r;
+            row[x * 3 + 1] = pixel.g;
+            row[x * 3 + 2] = pixel.b;
+        }
+
+        fwrite(row.data(), 1, row.size(), file);
+    }
+
+    return fclose(file) == 0;
+}
+
+// Same as the GL blend raylib uses: src * alpha + dst * (1 - alpha)
+void SoftwareRenderer::blend(int x, int y, Color color)
+{
+    if (color.a == 0) return;
+
+    Color& dst = pixels[(size_t)y * width + x];
+
+    if (color.a == 255)
+    {
+        dst = color;
+        return;
+    }
+
+    const int alpha = color.a;
+    dst.r = (unsigned char)((color.r * alpha + dst.r * (255 - alpha) + 127) / 255);
+    dst.g = (unsigned char)((color.g * alpha + dst.g * (255 - alpha) + 127) / 255);
+    dst.b = (unsigned char)((color.b * alpha + dst.b * (255 - alpha) + 127) / 255);
+    dst.a = 255;
+}
+
+void SoftwareRenderer::fillRect(float x, float y, float w, float h, Color color)
+{
+    const int x0 = std::max((int)lroundf(x), 0);
+    const int y0 = std::max((int)lroundf(y), 0);
+    const int x1 = std::min((int)lroundf(x + w), width);
+    const int y1 = std::min((int)lroundf(y + h), height);
+
+    for (int py = y0; py < y1; py++)
+    {
+        for (int px = x0; px < x1; px++) blend(px, py, color);
+    }
+}
+
+static bool InsideRounded(float px, float py, const Rectangle& rec, float radius)
+{
+    if (px < rec.x || py < rec.y || px > rec.x + rec.width || py > rec.y + rec.height) return false;
+
+    // Distance to the inner rectangle the corners are centred on
+    const float cx = std::min(std::max(px, rec.x + radius), rec.x + rec.width - radius);
+    const float cy = std::min(std::max(py, rec.y + radius), rec.y + rec.height - radius);
+
+    return (px - cx) * (px - cx) + (py - cy) * (py - cy) <= radius * radius;
+}
+
+void SoftwareRenderer::fillRounded(Rectangle outer, float outerRadius, const Rectangle* inner, float innerRadius, Color color)
+{
+    const int x0 = std::max((int)floorf(outer.x), 0);
+    const int y0 = std::max((int)floorf(outer.y), 0);
+    const int x1 = std::min((int)ceilf(outer.x + outer.width), width);
+    const int y1 = std::min((int)ceilf(outer.y + outer.height), height);
+
+    for (int y = y0; y < y1; y++)
+    {
+        const float py = y + 0.5f;
+
+        for (int x = x0; x < x1; x++)
+        {
+            const float px = x + 0.5f;
+
+            if (!InsideRounded(px, py, outer, outerRadius)) continue;
+            if (inner != nullptr && InsideRounded(px, py, *inner, innerRadius)) continue;
+
+            blend(x, y, color);
+        }
+    }
+}
+
+Texture2D SoftwareRenderer::loadTexture(Image image)
+{
+    Image copy = ImageCopy(image);
+    ImageFormat(&copy, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    textures.push_back(copy);
+
+    Texture2D texture = {};
+    texture.id = (unsigned int)textures.size();
+    texture.width = copy.width;
+    texture.height = copy.height;
+    texture.mipmaps = 1;
+    texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+    return texture;
+}
+
+void SoftwareRenderer::unloadTexture(Texture2D texture)
+{
+    if (texture.id == 0 || texture.id > textures.size()) return;
+
+    Image& image = textures[texture.id - 1];
+    if (image.data != nullptr) UnloadImage(image);
+    image = Image{};
+}
+
+void SoftwareRenderer::drawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint)
+{
+    if (texture.id == 0 || texture.id > textures.size() || dest.width <= 0 || dest.height <= 0) return;
+
+    const Image& image = textures[texture.id - 1];
+    if (image.data == nullptr) return;
+
+    const Color* texels = (const Color*)image.data;
+    const float radians = rotation * DEG2RAD;
+    const float cosRot = cosf(radians);
+    const float sinRot = sinf(radians);
+
+    // Screen bounds of the rotated quad, the same corners DrawTexturePro builds
+    float minX = dest.x, maxX = dest.x, minY = dest.y, maxY = dest.y;
+    const float cornersX[4] = { -origin.x, dest.width - origin.x, -origin.x, dest.width - origin.x };
+    const float cornersY[4] = { -origin.y, -origin.y, dest.height - origin.y, dest.height - origin.y };
+
+    for (int i = 0; i < 4; i++)
+    {
+        const float x = dest.x + cornersX[i] * cosRot - cornersY[i] * sinRot;
+        const float y = dest.y + cornersX[i] * sinRot + cornersY[i] * cosRot;
+
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    }
+
+    const int x0 = std::max((int)floorf(minX), 0);
+    const int y0 = std::max((int)floorf(minY), 0);
+    const int x1 = std::min((int)ceilf(maxX), width);
+    const int y1 = std::min((int)ceilf(maxY), height);
+
+    const float scaleU = fabsf(source.width) / dest.width;
+    const float scaleV = fabsf(source.height) / dest.height;
+
+    for (int y = y0; y < y1; y++)
+    {
+        const float dy = y + 0.5f - dest.y;
+
+        for (int x = x0; x < x1; x++)
+        {
+            const float dx = x + 0.5f - dest.x;
+
+            // Back to the unrotated quad
+            const float localX = dx * cosRot + dy * sinRot + origin.x;
+            const float localY = -dx * sinRot + dy * cosRot + origin.y;
+
+            if (localX < 0 || localY < 0 || localX >= dest.width || localY >= dest.height) continue;
+
+            float u = localX * scaleU;
+            float v = localY * scaleV;
+
+            // Negative source sizes flip, as in raylib
+            u = (source.width < 0) ? source.x - u : source.x + u;
+            v = (source.height < 0) ? source.y - v : source.y + v;
+
+            const int tx = std::min(std::max((int)floorf(u), 0), image.width - 1);
+            const int ty = std::min(std::max((int)floorf(v), 0), image.height - 1);
+            const Color texel = texels[(size_t)ty * image.width + tx];
+
+            blend(x, y, Color
+            {
+                (unsigned char)(texel.r * tint.r / 255),
+                (unsigned char)(texel.g * tint.g / 255),
+                (unsigned char)(texel.b * tint.b / 255),
+                (unsigned char)(texel.a * tint.a / 255)
+            });
+        }
+    }
+}
+
+void SoftwareRenderer::drawCircle(Vector2 center, float radius, Color color)
+{
+    const int x0 = std::max((int)floorf(center.x - radius), 0);
+    const int y0 = std::max((int)floorf(center.y - radius), 0);
+    const int x1 = std::min((int)ceilf(center.x + radius), width);
+    const int y1 = std::min((int)ceilf(center.y + radius), height);
+
+    for (int y = y0; y < y1; y++)
+    {
+        const float dy = y + 0.5f - center.y;
+
+        for (int x = x0; x < x1; x++)
+        {
+            const float dx = x + 0.5f - center.x;
+            if (dx * dx + dy * dy <= radius * radius) blend(x, y, color);
+        }
+    }
+}
+
+void SoftwareRenderer::drawLine(Vector2 start, Vector2 end, Color color)
+{
+    const float dx = end.x - start.x;
+    const float dy = end.y - start.y;
+    const int steps = std::max((int)ceilf(std::max(fabsf(dx), fabsf(dy))), 1);
+
+    for (int i = 0; i <= steps; i++)
+    {
+        const int x = (int)floorf(start.x + dx * i / steps);
+        const int y = (int)floorf(start.y + dy * i / steps);
+
+        if (x >= 0 && y >= 0 && x < width && y < height) blend(x, y, color);
+    }
+}
+
+void SoftwareRenderer::drawRectangleRounded(Rectangle rec, float roundness, int segments, Color color)
+{
+    (void)segments;
+    if (rec.width <= 0 || rec.height <= 0) return;
+
+    const float radius = std::min(rec.width, rec.height) * std::min(std::max(roundness, 0.0f), 1.0f) * 0.5f;
+    fillRounded(rec, radius, nullptr, 0.0f, color);
+}
+
+void SoftwareRenderer::drawRectangleRoundedLines(Rectangle rec, float roundness, int segments, int lineThick, Color color)
+{
+    (void)segments;
+    if (rec.width <= 0 || rec.height <= 0) return;
+
+    // raylib grows the outline outwards, rec stays the inside edge
+    const float thick = (float)std::max(lineThick, 1);
+    const float radius = std::min(rec.width, rec.height) * std::min(std::max(roundness, 0.0f), 1.0f) * 0.5f;
+    const Rectangle outer = { rec.x - thick, rec.y - thick, rec.width + thick * 2, rec.height + thick * 2 };
+
+    fillRounded(outer, radius + thick, &rec, radius, color);
+}
+
+void SoftwareRenderer::drawText(const char text[], int posX, int posY, int fontSize, Color color)
+{
+    if (fontSize < fontBaseSize) fontSize = fontBaseSize;
+
+    const float scale = (float)fontSize / fontBaseSize;
+    const int spacing = fontSize / fontBaseSize;
+
+    float penX = (float)posX;
+    float penY = (float)posY;
+
+    for (const char* c = text; *c != '\0'; c++)
+    {
+        if (*c == '\n')
+        {
+            penX = (float)posX;
+            penY += (fontBaseSize + fontBaseSize / 2) * scale;
+            continue;
+        }
+
+        const int glyph = (*c >= ' ' && *c <= '~') ? *c - ' ' : '?' - ' ';
+
+        for (int column = 0; column < glyphColumns; column++)
+        {
+            const unsigned char bits = font5x7[glyph][column];
+
+            for (int row = 0; row < 7; row++)
+            {
+                if (bits & (1 << row)) fillRect(penX + column * scale, penY + (row + 1) * scale, scale, scale, color);
+            }
+        }
+
+        penX += glyphAdvance * scale + spacing;
+    }
+}
+
+int SoftwareRenderer::measureText(const char text[], int fontSize)
+{
+    if (fontSize < fontBaseSize) fontSize = fontBaseSize;
+
+    const float scale = (float)fontSize / fontBaseSize;
+    const int spacing = fontSize / fontBaseSize;
+
+    int longest = 0;
+    int count = 0;
+
+    for (const char* c = text; ; c++)
+    {
+        if (*c == '\n' || *c == '\0')
+        {
+            longest = std::max(longest, count);
+            count = 0;
+
+            if (*c == '\0') break;
+            continue;
+        }
+
+        count++;
+    }
+
+    if (longest == 0) return 0;
+
+    return (int)(longest * (glyphAdvance * scale + spacing) - spacing);
+}
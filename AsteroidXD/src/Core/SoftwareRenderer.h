@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "RenderBackend.h"
+
+/// <summary>
+/// Backend que dibuja en memoria, sin GPU: quads con textura rotados, circulos,
+/// rectangulos redondeados, lineas y texto (con una fuente 5x7 propia, la de raylib vive en la GPU).
+/// Muestrea como el filtro POINT de raylib y mezcla con alpha; sirve para capturas de referencia
+/// y para medir cuanto cuesta dibujar un frame en maquinas sin placa de video.
+/// </summary>
+class SoftwareRenderer : public RenderBackend
+{
+private:
+    int width;
+    int height;
+    std::vector<Color> pixels;
+
+    // Texture id - 1, RGBA copies of the uploaded images
+    std::vector<Image> textures;
+
+private:
+    void blend(int x, int y, Color color);
+    void fillRect(float x, float y, float w, float h, Color color);
+    void fillRounded(Rectangle outer, float outerRadius, const Rectangle* inner, float innerRadius, Color color);
+
+public:
+    SoftwareRenderer(int width, int height);
+    ~SoftwareRenderer();
+
+    SoftwareRenderer(const SoftwareRenderer&) = delete;
+    SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+
+    void clear(Color color);
+
+    int getWidth() const;
+    int getHeight() const;
+    const std::vector<Color>& getPixels() const;
+
+    /// <summary>
+    /// Hash FNV-1a del frame, para comparar contra una captura de referencia sin guardar la imagen
+    /// </summary>
+    /// <returns></returns>
+    uint64_t hash() const;
+
+    /// <summary>
+    /// Guarda el frame como PPM binario (P6)
+    /// </summary>
+    /// <param name="fileName"></param>
+    /// <returns></returns>
+    bool savePpm(const char fileName[]) const;
+
+    Texture2D loadTexture(Image image) override;
+    void unloadTexture(Texture2D texture) override;
+
+    void drawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) override;
+    void drawCircle(Vector2 center, float radius, Color color) override;
+    void drawLine(Vector2 start, Vector2 end, Color color) override;
+    void drawRectangleRounded(Rectangle rec, float roundness, int segments, Color color) override;
+    void drawRectangleRoundedLines(Rectangle rec, float roundness, int segments, int lineThick, Color color) override;
+    void drawText(const char text[], int posX, int posY, int fontSize, Color color) override;
+    int measureText(const char text[], int fontSize) override;
+};
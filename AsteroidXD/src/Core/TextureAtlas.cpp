@@ -0,0 +1,95 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+TextureAtlas::TextureAtlas(int padding) : padding(padding) { }
+
+TextureAtlas::~TextureAtlas()
+{
+    for (PendingImage& entry : pending) UnloadImage(entry.image);
+}
+
+void TextureAtlas::add(const char url[], Image image)
+{
+    pending.push_back(PendingImage{ url, image });
+}
+
+Image TextureAtlas::build()
+{
+    if (pending.empty()) return Image{};
+
+    // Tallest first, so every shelf wastes as little height as possible
+    std::sort(pending.begin(), pending.end(), [](const PendingImage& a, const PendingImage& b)
+    {
+        return a.image.height > b.image.height;
+    });
+
+    int widest = 0;
+    float area = 0.0f;
+
+    for (PendingImage& entry : pending)
+    {
+        ImageFormat(&entry.image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+        widest = std::max(widest, entry.image.width + padding * 2);
+        area += (float)(entry.image.width + padding * 2) * (float)(entry.image.height + padding * 2);
+    }
+
+    int width = 64;
+    while (width < widest || width < (int)ceilf(sqrtf(area))) width *= 2;
+
+    // Shelf packing, the padding stays transparent so neighbours never bleed in
+    int x = 0;
+    int y = 0;
+    int shelfHeight = 0;
+
+    for (PendingImage& entry : pending)
+    {
+        const int w = entry.image.width + padding * 2;
+        const int h = entry.image.height + padding * 2;
+
+        if (x + w > width)
+        {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+
+        regions[entry.url] = Rectangle{ (float)(x + padding), (float)(y + padding), (float)entry.image.width, (float)entry.image.height };
+
+        x += w;
+        shelfHeight = std::max(shelfHeight, h);
+    }
+
+    Image atlas = GenImageColor(width, y + shelfHeight, BLANK);
+    unsigned char* pixels = (unsigned char*)atlas.data;
+
+    for (PendingImage& entry : pending)
+    {
+        const Rectangle& region = regions[entry.url];
+        const unsigned char* source = (const unsigned char*)entry.image.data;
+        const size_t rowBytes = (size_t)entry.image.width * 4;
+
+        for (int row = 0; row < entry.image.height; row++)
+        {
+            memcpy(pixels + (((size_t)region.y + row) * width + (size_t)region.x) * 4, source + row * rowBytes, rowBytes);
+        }
+
+        UnloadImage(entry.image);
+    }
+
+    pending.clear();
+
+    return atlas;
+}
+
+int TextureAtlas::getPendingCount() const
+{
+    return (int)pending.size();
+}
+
+const std::unordered_map<std::string, Rectangle>& TextureAtlas::getRegions() const
+{
+    return regions;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "raylib.h"
+
+/// <summary>
+/// Junta varias imagenes en una sola textura y guarda el rectangulo de cada una por ruta.
+/// Dibujar todo lo que esta en el atlas no cambia de textura, asi raylib lo manda en un solo batch.
+/// </summary>
+class TextureAtlas
+{
+private:
+    struct PendingImage
+    {
+        std::string url;
+        Image image;
+    };
+
+    std::vector<PendingImage> pending;
+    std::unordered_map<std::string, Rectangle> regions;
+    int padding;
+
+public:
+    TextureAtlas(int padding = 2);
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    /// <summary>
+    /// Agrega una imagen decodificada, el atlas se queda con ella
+    /// </summary>
+    /// <param name="url"></param>
+    /// <param name="image"></param>
+    void add(const char url[], Image image);
+
+    /// <summary>
+    /// Acomoda las imagenes en filas (de la mas alta a la mas baja) y las copia a una sola imagen RGBA.
+    /// Libera las imagenes agregadas; se puede llamar desde cualquier hilo, subirla a la GPU no
+    /// </summary>
+    /// <returns>La imagen del atlas, vacia si no se agrego nada</returns>
+    Image build();
+
+    int getPendingCount() const;
+    const std::unordered_map<std::string, Rectangle>& getRegions() const;
+};
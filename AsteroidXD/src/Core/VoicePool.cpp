@@ -0,0 +1,175 @@
+#include "VoicePool.h"
+#include <algorithm>
+
+VoicePool& VoicePool::instance()
+{
+    static VoicePool pool;
+    return pool;
+}
+
+int VoicePool::addSample(const char url[], SampleSettings settings)
+{
+    for (int i = 0; i < (int)samples.size(); i++)
+    {
+        if (samples[i].url == url) return i;
+    }
+
+    if (settings.maxInstances < 1) settings.maxInstances = 1;
+
+    const int id = (int)samples.size();
+    samples.push_back(Sample{ url, settings, (int)voices.size() });
+
+    for (int voice = 0; voice < settings.maxInstances; voice++)
+    {
+        voices.push_back(Voice{ assets.loadSound(AssetCache::voiceUrl(url, voice).c_str()), id, 0 });
+    }
+
+    return id;
+}
+
+void VoicePool::play(int sample, float pitch, float volume)
+{
+    if (sample < 0 || sample >= (int)samples.size()) return;
+
+    stats.requested++;
+    pending.push_back(SoundEvent{ sample, pitch, volume });
+}
+
+VoicePool::Voice* VoicePool::findVictim(int priority)
+{
+    Voice* victim = nullptr;
+    int victimPriority = priority;
+
+    for (Voice& voice : voices)
+    {
+        const int voicePriority = samples[voice.sample].settings.priority;
+
+        if (voicePriority > priority || !IsSoundPlaying(voice.sound)) continue;
+
+        if (victim == nullptr || voicePriority < victimPriority || (voicePriority == victimPriority && voice.started < victim->started))
+        {
+            victim = &voice;
+            victimPriority = voicePriority;
+        }
+    }
+
+    return victim;
+}
+
+void VoicePool::update()
+{
+    if (pending.empty()) return;
+
+    // Highest priority first so it picks its voice before the rest, the loudest request of a sample leads its group
+    std::sort(pending.begin(), pending.end(), [this](const SoundEvent& a, const SoundEvent& b)
+    {
+        const int priorityA = samples[a.sample].settings.priority;
+        const int priorityB = samples[b.sample].settings.priority;
+
+        if (priorityA != priorityB) return priorityA > priorityB;
+        if (a.sample != b.sample) return a.sample < b.sample;
+        return a.volume > b.volume;
+    });
+
+    int playing = getPlayingCount();
+
+    for (size_t e = 0; e < pending.size(); e++)
+    {
+        const SoundEvent& event = pending[e];
+
+        // The same sample twice in a frame sounds like one louder hit, it only gets one voice
+        if (e > 0 && pending[e - 1].sample == event.sample)
+        {
+            stats.merged++;
+            continue;
+        }
+
+        const Sample& sample = samples[event.sample];
+        Voice* voice = nullptr;
+        Voice* oldest = nullptr;
+
+        for (int i = sample.firstVoice; i < sample.firstVoice + sample.settings.maxInstances; i++)
+        {
+            if (!IsSoundPlaying(voices[i].sound))
+            {
+                voice = &voices[i];
+                break;
+            }
+
+            if (oldest == nullptr || voices[i].started < oldest->started) oldest = &voices[i];
+        }
+
+        if (voice == nullptr)
+        {
+            // Every instance is sounding, the oldest one starts over
+            voice = oldest;
+            StopSound(voice->sound);
+            stats.stolen++;
+        }
+        else if (playing >= voiceLimit)
+        {
+            Voice* victim = findVictim(sample.settings.priority);
+
+            if (victim == nullptr)
+            {
+                stats.dropped++;
+                continue;
+            }
+
+            StopSound(victim->sound);
+            stats.stolen++;
+        }
+        else playing++;
+
+        SetSoundPitch(voice->sound, event.pitch);
+        SetSoundVolume(voice->sound, sample.settings.volume * event.volume);
+        PlaySound(voice->sound);
+
+        voice->started = ++playCount;
+        stats.played++;
+    }
+
+    pending.clear();
+}
+
+void VoicePool::stopAll()
+{
+    for (Voice& voice : voices) StopSound(voice.sound);
+    pending.clear();
+}
+
+void VoicePool::release()
+{
+    stopAll();
+    assets.release();
+
+    samples.clear();
+    voices.clear();
+}
+
+void VoicePool::setVoiceLimit(int limit)
+{
+    voiceLimit = std::max(limit, 1);
+}
+
+int VoicePool::getVoiceLimit() const
+{
+    return voiceLimit;
+}
+
+int VoicePool::getPlayingCount() const
+{
+    int playing = 0;
+
+    for (const Voice& voice : voices)
+    {
+        if (IsSoundPlaying(voice.sound)) playing++;
+    }
+
+    return playing;
+}
+
+const VoiceStats& VoicePool::getStats() const
+{
+    return stats;
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "raylib.h"
+#include "AssetScope.h"
+
+/// <summary>
+/// Como suena un sample dentro del pool
+/// </summary>
+struct SampleSettings
+{
+    // Buffers of the sample, it never sounds more times at once
+    int maxInstances = 1;
+
+    // With every voice busy a sample takes the voice of one with lower or equal priority
+    int priority = 0;
+
+    float volume = 1.0f;
+};
+
+/// <summary>
+/// Contadores desde el inicio: pedidos, reproducidos, unidos en el mismo frame, voces robadas y descartados
+/// </summary>
+struct VoiceStats
+{
+    unsigned int requested = 0;
+    unsigned int played = 0;
+    unsigned int merged = 0;
+    unsigned int stolen = 0;
+    unsigned int dropped = 0;
+};
+
+/// <summary>
+/// Voces de los efectos de sonido: la jugabilidad pide eventos con play() y update() decide una vez por frame
+/// que suena. Cada sample tiene maxInstances buffers propios y entre todos nunca suenan mas de voiceLimit,
+/// los pedidos del mismo sample en un frame se unen en uno y si no hay voz libre el de mayor prioridad
+/// le saca la suya al de menor. La memoria y el costo de mezcla quedan fijos aunque exploten cientos de meteoros.
+/// </summary>
+class VoicePool
+{
+private:
+    struct Sample
+    {
+        std::string url;
+        SampleSettings settings;
+        int firstVoice;
+    };
+
+    struct Voice
+    {
+        Sound sound;
+        int sample;
+
+        // Play order, the lowest is the oldest voice
+        unsigned long long started;
+    };
+
+    struct SoundEvent
+    {
+        int sample;
+        float pitch;
+        float volume;
+    };
+
+    std::vector<Sample> samples;
+    std::vector<Voice> voices;
+    std::vector<SoundEvent> pending;
+    AssetScope assets{ "voices" };
+
+    int voiceLimit = 8;
+    unsigned long long playCount = 0;
+    VoiceStats stats;
+
+private:
+    VoicePool() = default;
+
+    // Oldest voice of the lowest priority sounding, only from samples with priority or less
+    Voice* findVictim(int priority);
+
+public:
+    VoicePool(const VoicePool&) = delete;
+    VoicePool& operator=(const VoicePool&) = delete;
+
+    static VoicePool& instance();
+
+    /// <summary>
+    /// Registra un sample y carga sus voces del cache, si la ruta ya estaba devuelve el mismo id sin cambiar su configuracion
+    /// </summary>
+    /// <param name="url"></param>
+    /// <param name="settings"></param>
+    /// <returns>Id para play()</returns>
+    int addSample(const char url[], SampleSettings settings = SampleSettings{});
+
+    /// <summary>
+    /// Pide que suene el sample en el proximo update()
+    /// </summary>
+    /// <param name="sample"></param>
+    /// <param name="pitch"></param>
+    /// <param name="volume">Se multiplica por el volumen del sample</param>
+    void play(int sample, float pitch = 1.0f, float volume = 1.0f);
+
+    /// <summary>
+    /// Reparte las voces entre los pedidos del frame, una vez por frame
+    /// </summary>
+    void update();
+
+    void stopAll();
+
+    /// <summary>
+    /// Suelta las voces y olvida los samples, los ids dejan de ser validos
+    /// </summary>
+    void release();
+
+    void setVoiceLimit(int limit);
+    int getVoiceLimit() const;
+    int getPlayingCount() const;
+    const VoiceStats& getStats() const;
+};
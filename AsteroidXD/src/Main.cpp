@@ -1,7 +1,81 @@
+#include <cstdlib>
+#include <cstring>
 #include "Core/GameManager.h"
+#include "Core/AssetPacker.h"
+#include "Core/CheckRunner.h"
+#include "Core/CoopRunner.h"
+#include "Core/RenderRunner.h"
+#include "Core/ReplayRunner.h"
+#include "Core/ServerRunner.h"
+#include "Utils/Console.h"
+#include "Utils/JobSystem.h"
 
+// Modes that report with printf and never open a window
+static bool IsHeadless(int argc, char* argv[])
+{
+    static const char* const flags[] = { "--replay", "--pack", "--render", "--coop-test", "--server", "--check" };
+
+    for (const char* flag : flags)
+    {
+        if (argc > 1 && strcmp(argv[1], flag) == 0) return true;
+    }
+
+    return false;
+}
 
-void main()
+int main(int argc, char* argv[])
 {
-    Run();
-}
\ No newline at end of file
+    // The Release build has no console of its own, the reports go to the one that launched it or to a new one
+    if (IsHeadless(argc, argv)) AttachConsoleOutput();
+
+    // One worker per core besides this thread, the simulation splits big meteor fields between them
+    JobSystem::instance().start();
+
+    int exitCode = 0;
+
+    // Headless: AsteroidXD --replay replay_a.axdr replay_b.axdr ...
+    if (argc > 1 && strcmp(argv[1], "--replay") == 0) exitCode = RunReplays(argc - 2, argv + 2);
+    // Build step: AsteroidXD --pack resources.axdp, run where the resources folder is
+    else if (argc > 2 && strcmp(argv[1], "--pack") == 0) exitCode = PackResources(argv[2]);
+    // Headless drawing: AsteroidXD --render 120 [frame], prints a hash per frame and optionally saves frame_NNN.ppm
+    else if (argc > 2 && strcmp(argv[1], "--render") == 0) exitCode = RunRenderTest(atoi(argv[2]), argc > 3 ? argv[3] : nullptr);
+    // Co-op on this machine: AsteroidXD --coop 1 and AsteroidXD --coop 2 [latency ms] [loss %]
+    else if (argc > 2 && strcmp(argv[1], "--coop") == 0)
+    {
+        NetConditions conditions;
+        conditions.latency = (argc > 3) ? atof(argv[3]) / 1000.0 : 0.0;
+        conditions.loss = (argc > 4) ? (float)atof(argv[4]) / 100.0f : 0.0f;
+
+        exitCode = RunCoop(atoi(argv[2]) == 2 ? 1 : 0, conditions);
+    }
+    // Headless co-op: AsteroidXD --coop-test 3600 [latency ms] [jitter ms] [loss %] [--udp], one row per input delay
+    else if (argc > 2 && strcmp(argv[1], "--coop-test") == 0)
+    {
+        NetConditions conditions;
+        int arg = 3;
+        bool udp = false;
+
+        if (arg < argc && strcmp(argv[arg], "--udp") != 0) conditions.latency = atof(argv[arg++]) / 1000.0;
+        if (arg < argc && strcmp(argv[arg], "--udp") != 0) conditions.jitter = atof(argv[arg++]) / 1000.0;
+        if (arg < argc && strcmp(argv[arg], "--udp") != 0) conditions.loss = (float)atof(argv[arg++]) / 100.0f;
+        if (arg < argc && strcmp(argv[arg], "--udp") == 0) udp = true;
+
+        exitCode = RunCoopTest(atoi(argv[2]), conditions, udp);
+    }
+    // Headless server: AsteroidXD --server 256 [ticks] [latency ms] [loss %], clients on loopback in the same process
+    else if (argc > 2 && strcmp(argv[1], "--server") == 0)
+    {
+        NetConditions conditions;
+        conditions.latency = (argc > 4) ? atof(argv[4]) / 1000.0 : 0.0;
+        conditions.loss = (argc > 5) ? (float)atof(argv[5]) / 100.0f : 0.0f;
+
+        exitCode = RunServerTest(atoi(argv[2]), (argc > 3) ? atoi(argv[3]) : 1200, conditions);
+    }
+    // Headless checks of the simulation rules: AsteroidXD --check
+    else if (argc > 1 && strcmp(argv[1], "--check") == 0) exitCode = RunChecks();
+    // AsteroidXD --record saves the inputs of every attempt next to the executable
+    else Run(argc > 1 && strcmp(argv[1], "--record") == 0);
+
+    JobSystem::instance().stop();
+    return exitCode;
+}
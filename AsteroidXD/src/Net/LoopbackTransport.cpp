@@ -0,0 +1,55 @@
+#include "LoopbackTransport.h"
+#include <cstring>
+
+LoopbackTransport::~LoopbackTransport()
+{
+    disconnect();
+}
+
+void LoopbackTransport::connect(LoopbackTransport& a, LoopbackTransport& b)
+{
+    a.disconnect();
+    b.disconnect();
+
+    a.peer = &b;
+    b.peer = &a;
+}
+
+void LoopbackTransport::disconnect()
+{
+    if (peer != nullptr) peer->peer = nullptr;
+    peer = nullptr;
+}
+
+bool LoopbackTransport::sendNow(const void* data, size_t size)
+{
+    if (peer == nullptr || peer->inbox.size() - peer->head >= maxQueued) return false;
+
+    Packet packet;
+    packet.size = size;
+    memcpy(packet.data, data, size);
+
+    peer->inbox.push_back(packet);
+
+    return true;
+}
+
+size_t LoopbackTransport::receiveNow(void* buffer, size_t capacity)
+{
+    if (head >= inbox.size()) return 0;
+
+    const Packet& packet = inbox[head++];
+
+    // Like recvfrom, a datagram bigger than the buffer is cut
+    const size_t size = (packet.size < capacity) ? packet.size : capacity;
+    memcpy(buffer, packet.data, size);
+
+    // Once everything was read the queue starts over, keeping its memory
+    if (head == inbox.size())
+    {
+        inbox.clear();
+        head = 0;
+    }
+
+    return size;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+#include "Transport.h"
+
+/// <summary>
+/// Transporte en memoria entre dos objetos del mismo proceso, para probar el rollback
+/// en una sola maquina y de forma repetible: con el mismo reloj y la misma semilla
+/// se pierden y demoran siempre los mismos datagramas.
+/// </summary>
+class LoopbackTransport : public Transport
+{
+private:
+    struct Packet
+    {
+        size_t size;
+        unsigned char data[maxDatagramSize];
+    };
+
+    // Like a socket buffer, what does not fit is dropped
+    static const size_t maxQueued = 256;
+
+    LoopbackTransport* peer = nullptr;
+    std::vector<Packet> inbox;
+    size_t head = 0;
+
+protected:
+    bool sendNow(const void* data, size_t size) override;
+    size_t receiveNow(void* buffer, size_t capacity) override;
+
+public:
+    LoopbackTransport() = default;
+    LoopbackTransport(const LoopbackTransport&) = delete;
+    LoopbackTransport& operator=(const LoopbackTransport&) = delete;
+    ~LoopbackTransport();
+
+    /// <summary>
+    /// Une los dos extremos, lo que envia uno lo recibe el otro
+    /// </summary>
+    /// <param name="a"></param>
+    /// <param name="b"></param>
+    static void connect(LoopbackTransport& a, LoopbackTransport& b);
+    void disconnect();
+};
@@ -0,0 +1,270 @@
+#include "MatchServer.h"
+#include <chrono>
+#include "Utils/ByteStream.h"
+#include "Utils/JobSystem.h"
+#include "Utils/Profiler.h"
+
+// Frame the clients start from, and the baseline of anyone whose ack is gone from the history
+static const NetFrame emptyFrame{ };
+
+const int MatchServer::frameHistory;
+
+MatchServer::MatchServer(const SimConfig& config, const ServerSettings& settings) :
+    config(config),
+    settings(settings),
+    codec(config, settings.step)
+{
+    if (this->settings.sendInterval < 1) this->settings.sendInterval = 1;
+}
+
+int MatchServer::addMatch(uint64_t seed)
+{
+    matches.emplace_back(new Match(config));
+
+    Match& match = *matches.back();
+    match.seed = seed;
+    match.simulation.reset(1, seed);
+
+    return (int)matches.size() - 1;
+}
+
+void MatchServer::addClient(int match, int player, Transport& transport)
+{
+    Client client;
+    client.transport = &transport;
+    client.player = (player < matches[match]->simulation.getPlayerCount()) ? player : -1;
+
+    matches[match]->clients.push_back(client);
+}
+
+void MatchServer::update(double now)
+{
+    PROFILE_SCOPE("Server/Update");
+
+    const bool send = tick % settings.sendInterval == 0;
+
+    // Every match only touches its own simulation, clients and transports
+    JobSystem::instance().parallelFor((int)matches.size(), 1, [&](int begin, int end)
+    {
+        // Only the matches that run on the main thread would be measured, the tick is one sample instead
+        PROFILE_SUSPEND();
+
+        typedef std::chrono::steady_clock Clock;
+
+        for (int i = begin; i < end; i++)
+        {
+            Match& match = *matches[i];
+
+            Clock::time_point start = Clock::now();
+            receive(match, now);
+            simulate(match);
+
+            Clock::time_point simulated = Clock::now();
+            if (send) broadcast(match, now);
+
+            match.stats.simulateSeconds += std::chrono::duration<double>(simulated - start).count();
+            match.stats.encodeSeconds += std::chrono::duration<double>(Clock::now() - simulated).count();
+        }
+    });
+
+    tick++;
+
+    const unsigned long long ticks = stats.ticks + 1;
+    stats = ServerStats{ };
+    stats.ticks = ticks;
+
+    for (const std::unique_ptr<Match>& match : matches)
+    {
+        const ServerStats& m = match->stats;
+
+        stats.matchTicks += m.matchTicks;
+        stats.packetsSent += m.packetsSent;
+        stats.bytesSent += m.bytesSent;
+        stats.fullFrames += m.fullFrames;
+        stats.fullBytes += m.fullBytes;
+        stats.deltaFrames += m.deltaFrames;
+        stats.deltaBytes += m.deltaBytes;
+        stats.oversizedFrames += m.oversizedFrames;
+        stats.simulateSeconds += m.simulateSeconds;
+        stats.encodeSeconds += m.encodeSeconds;
+    }
+}
+
+void MatchServer::receive(Match& match, double now)
+{
+    unsigned char packet[Transport::maxDatagramSize];
+    size_t size;
+
+    for (Client& client : match.clients)
+    {
+        while ((size = client.transport->receive(packet, sizeof(packet), now)) > 0)
+        {
+            if (size != stateInputPacketSize) continue;
+
+            ByteReader reader(packet, size);
+            bool valid = true;
+
+            for (char c : statePacketMagic) valid = valid && reader.read<char>() == c;
+            if (!valid || (StatePacketType)reader.read<uint8_t>() != StatePacketType::Input) continue;
+
+            const uint32_t sequence = reader.read<uint32_t>();
+            const int32_t ack = reader.read<int32_t>();
+            const int16_t aimX = reader.read<int16_t>();
+            const int16_t aimY = reader.read<int16_t>();
+            const uint8_t flags = reader.read<uint8_t>();
+
+            // Datagrams can arrive out of order, only the newest one counts
+            if (reader.hasFailed() || (client.hasInput && sequence <= client.inputSequence)) continue;
+
+            client.inputSequence = sequence;
+            client.hasInput = true;
+            client.ackTick = (ack < tick) ? ack : -1;
+
+            client.aimX = aimX;
+            client.aimY = aimY;
+            client.flags = flags;
+        }
+    }
+}
+
+void MatchServer::simulate(Match& match)
+{
+    Simulation& simulation = match.simulation;
+
+    // The match goes on by itself: the next level after a win, level 1 with a new seed after a loss
+    if (simulation.isVictory()) simulation.reset(simulation.getLevel() + 1, match.seed);
+    else if (simulation.isGameOver()) simulation.reset(1, ++match.seed);
+
+    SimInput inputs[Simulation::maxPlayers];
+
+    for (int player = 0; player < simulation.getPlayerCount(); player++) inputs[player].aim = simulation.getShip(player).position;
+
+    // The last input of each player holds until a newer one arrives
+    for (const Client& client : match.clients)
+    {
+        if (client.player < 0 || !client.hasInput) continue;
+
+        // Without aim the ship aims at itself and keeps its rotation
+        SimInput& input = inputs[client.player];
+        if (client.flags & stateAimFlag) input.aim = Vector2{ (float)client.aimX, (float)client.aimY };
+        input.thrust = (client.flags & stateThrustFlag) != 0;
+        input.fire = (client.flags & stateFireFlag) != 0;
+    }
+
+    simulation.step(inputs, simulation.getPlayerCount(), settings.step);
+    match.stats.matchTicks++;
+}
+
+const EncodedFrame* MatchServer::encodeFor(Match& match, const Client& client)
+{
+    const NetFrame* baseline = &emptyFrame;
+
+    if (client.ackTick >= 0 && tick - client.ackTick < frameHistory)
+    {
+        const NetFrame& acked = match.frames[client.ackTick % frameHistory];
+        if (acked.tick == client.ackTick) baseline = &acked;
+    }
+
+    for (int i = 0; i < match.encodedCount; i++)
+    {
+        if (match.encoded[i].baselineTick == baseline->tick) return &match.encoded[i];
+    }
+
+    if (match.encodedCount == (int)match.encoded.size()) match.encoded.emplace_back();
+
+    EncodedFrame& encoded = match.encoded[match.encodedCount++];
+
+    // An oversized frame stays with no parts, the clients that share its baseline skip it too
+    if (!codec.encode(match.frames[tick % frameHistory], *baseline, Transport::maxDatagramSize - stateFrameHeaderSize, encoded))
+    {
+        encoded.partEnds.clear();
+        match.stats.oversizedFrames++;
+    }
+
+    return &encoded;
+}
+
+void MatchServer::broadcast(Match& match, double now)
+{
+    codec.capture(match.simulation, tick, match.frames[tick % frameHistory]);
+    match.encodedCount = 0;
+
+    unsigned char packet[Transport::maxDatagramSize];
+
+    for (const Client& client : match.clients)
+    {
+        const EncodedFrame& encoded = *encodeFor(match, client);
+        const int partCount = encoded.getPartCount();
+        size_t frameBytes = 0;
+
+        for (int part = 0; part < partCount; part++)
+        {
+            ByteWriter writer(packet, sizeof(packet));
+            for (char c : statePacketMagic) writer.write(c);
+            writer.write((uint8_t)StatePacketType::Frame);
+            writer.write(tick);
+            writer.write(encoded.baselineTick);
+            writer.write((uint8_t)part);
+            writer.write((uint8_t)partCount);
+
+            const size_t size = stateFrameHeaderSize + encoded.getPartSize(part);
+            memcpy(packet + stateFrameHeaderSize, encoded.getPart(part), encoded.getPartSize(part));
+
+            client.transport->send(packet, size, now);
+            frameBytes += size;
+        }
+
+        if (partCount == 0) continue;
+
+        match.stats.packetsSent += partCount;
+        match.stats.bytesSent += frameBytes;
+
+        if (encoded.baselineTick < 0)
+        {
+            match.stats.fullFrames++;
+            match.stats.fullBytes += frameBytes;
+        }
+        else
+        {
+            match.stats.deltaFrames++;
+            match.stats.deltaBytes += frameBytes;
+        }
+    }
+}
+
+#pragma region GETTERS
+
+int MatchServer::getMatchCount() const
+{
+    return (int)matches.size();
+}
+
+int32_t MatchServer::getTick() const
+{
+    return tick;
+}
+
+const Simulation& MatchServer::getSimulation(int match) const
+{
+    return matches[match]->simulation;
+}
+
+const NetFrame* MatchServer::getFrame(int match, int32_t tick) const
+{
+    if (tick < 0) return nullptr;
+
+    const NetFrame& frame = matches[match]->frames[tick % frameHistory];
+    return (frame.tick == tick) ? &frame : nullptr;
+}
+
+const StateCodec& MatchServer::getCodec() const
+{
+    return codec;
+}
+
+const ServerStats& MatchServer::getStats() const
+{
+    return stats;
+}
+
+#pragma endregion
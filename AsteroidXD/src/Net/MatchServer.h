@@ -0,0 +1,160 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "StateCodec.h"
+#include "Transport.h"
+
+#pragma region PACKETS
+
+// Server to client: magic, type, tick, baseline tick, part and part count, then the part itself.
+// Client to server: magic, type, sequence, last tick it has and its input.
+static const char statePacketMagic[4] = { 'A', 'X', 'D', 'S' };
+static const size_t stateFrameHeaderSize = 15;
+static const size_t stateInputPacketSize = 18;
+
+enum class StatePacketType : uint8_t
+{
+    Frame = 1,
+    Input = 2
+};
+
+static const uint8_t stateThrustFlag = 1;
+static const uint8_t stateFireFlag = 2;
+static const uint8_t stateAimFlag = 4;
+
+#pragma endregion
+
+/// <summary>
+/// Parametros del servidor, iguales para todas las partidas
+/// </summary>
+struct ServerSettings
+{
+    float step = 1.0f / 120.0f;
+
+    // Ticks between two state broadcasts, 2 sends at 60 Hz while simulating at 120
+    int sendInterval = 2;
+};
+
+/// <summary>
+/// Contadores del servidor desde que arranco. Los segundos son de CPU sumados entre todos los hilos,
+/// divididos por los ticks y las partidas dan lo que cuesta una partida en un core.
+/// </summary>
+struct ServerStats
+{
+    unsigned long long ticks = 0;
+    unsigned long long matchTicks = 0;
+
+    unsigned long long packetsSent = 0;
+    unsigned long long bytesSent = 0;
+
+    // Frames sent whole (a client without a usable baseline) and as a delta
+    unsigned long long fullFrames = 0;
+    unsigned long long fullBytes = 0;
+    unsigned long long deltaFrames = 0;
+    unsigned long long deltaBytes = 0;
+
+    // Frames that did not fit in StateCodec::maxParts datagrams
+    unsigned long long oversizedFrames = 0;
+
+    double simulateSeconds = 0.0;
+    double encodeSeconds = 0.0;
+};
+
+/// <summary>
+/// Servidor autoritativo sin ventana: corre muchas partidas independientes en un proceso, cada una con sus jugadores.
+/// Los clientes mandan su entrada y el ultimo tick que recibieron; el servidor les manda cada estado
+/// como diferencia contra ese tick, cuantizado y empaquetado en bits por StateCodec.
+/// Las partidas se reparten entre los hilos del JobSystem, cada una con sus clientes.
+/// </summary>
+class MatchServer
+{
+public:
+    // Broadcast frames kept per match as baselines, an ack older than this gets a full frame
+    static const int frameHistory = 32;
+
+private:
+    struct Client
+    {
+        Transport* transport;
+        int player;
+
+        // Last broadcast tick the client has, -1 none
+        int32_t ackTick = -1;
+
+        // Newest input packet, the older ones that arrive late are ignored
+        uint32_t inputSequence = 0;
+        bool hasInput = false;
+        int16_t aimX = 0;
+        int16_t aimY = 0;
+        uint8_t flags = 0;
+    };
+
+    struct Match
+    {
+        Simulation simulation;
+        std::vector<Client> clients;
+        NetFrame frames[frameHistory];
+
+        // One encoding per distinct baseline of this tick, clients that acked the same frame share it
+        std::vector<EncodedFrame> encoded;
+        int encodedCount = 0;
+
+        uint64_t seed;
+        ServerStats stats;
+
+        Match(const SimConfig& config) : simulation(config) { }
+    };
+
+    SimConfig config;
+    ServerSettings settings;
+    StateCodec codec;
+    std::vector<std::unique_ptr<Match>> matches;
+    int32_t tick = 0;
+    ServerStats stats;
+
+private:
+    void receive(Match& match, double now);
+    void simulate(Match& match);
+    void broadcast(Match& match, double now);
+    const EncodedFrame* encodeFor(Match& match, const Client& client);
+
+public:
+    MatchServer(const SimConfig& config, const ServerSettings& settings = ServerSettings{});
+
+    /// <summary>
+    /// Agrega una partida que empieza en el nivel 1, al perderla vuelve a empezar con la semilla siguiente
+    /// </summary>
+    /// <param name="seed"></param>
+    /// <returns>Indice de la partida</returns>
+    int addMatch(uint64_t seed);
+
+    /// <summary>
+    /// Conecta un cliente a una partida, el transporte tiene que vivir mientras el servidor
+    /// </summary>
+    /// <param name="match"></param>
+    /// <param name="player">Nave que maneja, -1 solo mira</param>
+    /// <param name="transport"></param>
+    void addClient(int match, int player, Transport& transport);
+
+    /// <summary>
+    /// Recibe las entradas, avanza todas las partidas un tick y, cada sendInterval ticks, envia el estado
+    /// </summary>
+    /// <param name="now">Reloj del llamador en segundos</param>
+    void update(double now);
+
+    int getMatchCount() const;
+    int32_t getTick() const;
+    const Simulation& getSimulation(int match) const;
+
+    /// <summary>
+    /// Frame enviado en ese tick si todavia esta en el historial
+    /// </summary>
+    /// <param name="match"></param>
+    /// <param name="tick"></param>
+    /// <returns>nullptr si no se envio o ya es muy viejo</returns>
+    const NetFrame* getFrame(int match, int32_t tick) const;
+
+    const StateCodec& getCodec() const;
+    const ServerStats& getStats() const;
+};
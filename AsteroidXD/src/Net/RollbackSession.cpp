@@ -0,0 +1,434 @@
+#include "RollbackSession.h"
+#include <algorithm>
+#include <cmath>
+#include "Utils/ByteStream.h"
+#include "Utils/Profiler.h"
+
+#pragma region PACKETS
+
+static const char packetMagic[4] = { 'A', 'X', 'D', 'N' };
+
+enum class PacketType : uint8_t
+{
+    // Host to guest until the guest answers: match, level and seed
+    Sync = 1,
+
+    // Both ways every frame: acks, clocks and the local inputs the peer does not have yet
+    Input = 2
+};
+
+// Magic, type and match
+static const size_t packetHeaderSize = 9;
+static const size_t inputSize = 5;
+static const int maxInputsPerPacket = 64;
+
+// Bounds of the settings, with them the peers are never historySize frames apart
+static const int maxInputDelay = 15;
+static const int maxRollbackFrames = 30;
+
+static const uint8_t thrustFlag = 1;
+static const uint8_t fireFlag = 2;
+static const uint8_t aimFlag = 4;
+
+static void WriteHeader(ByteWriter& writer, PacketType type, uint32_t matchId)
+{
+    for (char c : packetMagic) writer.write(c);
+    writer.write((uint8_t)type);
+    writer.write(matchId);
+}
+
+#pragma endregion
+
+RollbackSession::RollbackSession(Simulation& simulation, Transport& transport, int localPlayer, const RollbackSettings& settings) :
+    simulation(simulation),
+    transport(transport),
+    settings(settings),
+    localPlayer(localPlayer)
+{
+    this->settings.inputDelay = std::min(std::max(settings.inputDelay, 0), maxInputDelay);
+    this->settings.maxRollback = std::min(std::max(settings.maxRollback, 1), maxRollbackFrames);
+
+    for (std::vector<NetInput>& playerInputs : inputs) playerInputs.assign(historySize, NetInput{ 0, 0, 0 });
+
+    snapshots.resize(this->settings.maxRollback + 2);
+    snapshotSizes.assign(snapshots.size(), 0);
+}
+
+void RollbackSession::host(int level, uint64_t seed)
+{
+    // A new id every match, whatever is still in flight from the last one is ignored
+    matchId++;
+    startLevel = level;
+    startSeed = seed;
+
+    begin(level, seed);
+    state = State::Hosting;
+}
+
+void RollbackSession::join()
+{
+    state = State::Joining;
+}
+
+void RollbackSession::stop()
+{
+    state = State::Idle;
+}
+
+void RollbackSession::begin(int level, uint64_t seed)
+{
+    simulation.reset(level, seed);
+
+    frame = 0;
+    remoteConfirmed = -1;
+    peerAcked = -1;
+    rollbackFrom = -1;
+
+    for (std::vector<NetInput>& playerInputs : inputs) std::fill(playerInputs.begin(), playerInputs.end(), NetInput{ 0, 0, 0 });
+
+    // The frames before the first input are idle, and are sent as such so the peer needs no setup
+    localLast = settings.inputDelay - 1;
+
+    // The round trip is a property of the link, it carries over to the next match
+    const double roundTrip = stats.roundTrip;
+    stats = RollbackStats{ };
+    stats.roundTrip = roundTrip;
+    windowStart = -1.0;
+    windowResimulated = 0;
+}
+
+RollbackSession::NetInput& RollbackSession::inputAt(int player, int index)
+{
+    return inputs[player][index % historySize];
+}
+
+RollbackSession::NetInput RollbackSession::quantize(const SimInput& input) const
+{
+    NetInput net;
+    net.aimX = (int16_t)std::min(std::max(lroundf(input.aim.x), -32768L), 32767L);
+    net.aimY = (int16_t)std::min(std::max(lroundf(input.aim.y), -32768L), 32767L);
+    net.flags = aimFlag | (input.thrust ? thrustFlag : 0) | (input.fire ? fireFlag : 0);
+
+    return net;
+}
+
+SimInput RollbackSession::toSimInput(int player, const NetInput& input) const
+{
+    SimInput sim;
+
+    // Without aim the ship aims at itself and keeps its rotation
+    sim.aim = (input.flags & aimFlag) ? Vector2{ (float)input.aimX, (float)input.aimY } : simulation.getShip(player).position;
+    sim.thrust = (input.flags & thrustFlag) != 0;
+    sim.fire = (input.flags & fireFlag) != 0;
+
+    return sim;
+}
+
+bool RollbackSession::advance(const SimInput& localInput, double now)
+{
+    PROFILE_SCOPE("Net/Advance");
+
+    receivePackets(now);
+    if (rollbackFrom >= 0) rollback();
+
+    bool advanced = false;
+
+    if (isRunning())
+    {
+        // Past maxRollback predicted frames the snapshot to go back to would be gone
+        if (frame - remoteConfirmed > settings.maxRollback)
+        {
+            stats.stalls++;
+        }
+        else
+        {
+            const int target = frame + settings.inputDelay;
+
+            if (target > localLast)
+            {
+                // A longer delay leaves a gap, it holds the last input without firing again
+                NetInput hold = (localLast >= 0) ? inputAt(localPlayer, localLast) : NetInput{ 0, 0, 0 };
+                hold.flags &= ~fireFlag;
+
+                for (int f = localLast + 1; f < target; f++) inputAt(localPlayer, f) = hold;
+
+                inputAt(localPlayer, target) = quantize(localInput);
+                localLast = target;
+            }
+
+            simulateFrame();
+            stats.frames++;
+            advanced = true;
+        }
+
+        sendPacket(now);
+    }
+
+    updateWindow(now);
+
+    return advanced;
+}
+
+void RollbackSession::poll(double now)
+{
+    receivePackets(now);
+    if (rollbackFrom >= 0) rollback();
+
+    if (isRunning()) sendPacket(now);
+
+    updateWindow(now);
+}
+
+void RollbackSession::simulateFrame()
+{
+    // State before the frame, the one a late input of this frame rolls back to
+    const int slot = frame % (int)snapshots.size();
+    const size_t needed = simulation.getSnapshotSize();
+
+    if (snapshots[slot].size() < needed) snapshots[slot].resize(needed);
+    snapshotSizes[slot] = simulation.saveSnapshot(snapshots[slot].data(), snapshots[slot].size());
+
+    const int remotePlayer = 1 - localPlayer;
+
+    if (frame > remoteConfirmed)
+    {
+        // Prediction: the peer keeps aiming and thrusting like in its last known frame, a shot is not repeated
+        NetInput predicted = (remoteConfirmed >= 0) ? inputAt(remotePlayer, remoteConfirmed) : NetInput{ 0, 0, 0 };
+        predicted.flags &= ~fireFlag;
+
+        inputAt(remotePlayer, frame) = predicted;
+    }
+
+    SimInput frameInputs[Simulation::maxPlayers];
+    for (int player = 0; player < Simulation::maxPlayers; player++) frameInputs[player] = toSimInput(player, inputAt(player, frame));
+
+    simulation.step(frameInputs, Simulation::maxPlayers, settings.step);
+    frame++;
+}
+
+void RollbackSession::rollback()
+{
+    PROFILE_SCOPE("Net/Rollback");
+
+    const int from = rollbackFrom;
+    const int target = frame;
+    rollbackFrom = -1;
+
+    if (from >= target) return;
+
+    const int slot = from % (int)snapshots.size();
+    simulation.loadSnapshot(snapshots[slot].data(), snapshotSizes[slot]);
+
+    // Same frames again, now with the inputs that arrived; the ones still missing are predicted again
+    frame = from;
+    while (frame < target) simulateFrame();
+
+    const int depth = target - from;
+
+    stats.rollbacks++;
+    stats.resimulatedFrames += depth;
+    stats.lastRollbackDepth = depth;
+    stats.maxRollbackDepth = std::max(stats.maxRollbackDepth, depth);
+    windowResimulated += depth;
+}
+
+void RollbackSession::receivePackets(double now)
+{
+    unsigned char packet[Transport::maxDatagramSize];
+    size_t size;
+
+    while ((size = transport.receive(packet, sizeof(packet), now)) > 0)
+    {
+        if (size < packetHeaderSize) continue;
+
+        ByteReader reader(packet, size);
+        bool valid = true;
+
+        for (char c : packetMagic) valid = valid && reader.read<char>() == c;
+        if (!valid) continue;
+
+        const PacketType type = (PacketType)reader.read<uint8_t>();
+        const uint32_t id = reader.read<uint32_t>();
+
+        if (type == PacketType::Sync)
+        {
+            const int32_t level = reader.read<int32_t>();
+            const uint64_t seed = reader.read<uint64_t>();
+
+            // The guest follows every new match of the host, also after one ended
+            const bool newMatch = state == State::Joining || (state == State::Running && id != matchId);
+
+            if (localPlayer != 0 && newMatch && !reader.hasFailed())
+            {
+                matchId = id;
+                startLevel = level;
+                startSeed = seed;
+                begin(level, seed);
+                state = State::Running;
+                lastReceived = now;
+            }
+        }
+        else if (type == PacketType::Input && id == matchId && isRunning())
+        {
+            handleInputs(reader, now);
+            lastReceived = now;
+
+            // The guest answered, the match is on
+            if (state == State::Hosting) state = State::Running;
+        }
+    }
+}
+
+void RollbackSession::handleInputs(ByteReader& reader, double now)
+{
+    const int32_t ack = reader.read<int32_t>();
+    const int32_t first = reader.read<int32_t>();
+    const int count = reader.read<uint8_t>();
+    const double sendTime = reader.read<double>();
+    const double echo = reader.read<double>();
+
+    if (reader.hasFailed() || count > maxInputsPerPacket || reader.getRemaining() != (size_t)count * inputSize) return;
+
+    peerAcked = std::min(std::max(peerAcked, (int)ack), localLast);
+
+    // Newest clock of the peer, echoed back with the time it was held here
+    if (sendTime > peerSendTime)
+    {
+        peerSendTime = sendTime;
+        peerReceivedAt = now;
+    }
+
+    if (echo >= 0.0)
+    {
+        const double sample = std::max(now - echo, 0.0);
+        stats.roundTrip = (stats.roundTrip > 0.0) ? stats.roundTrip * 0.9 + sample * 0.1 : sample;
+    }
+
+    const int remotePlayer = 1 - localPlayer;
+
+    for (int i = 0; i < count; i++)
+    {
+        NetInput input;
+        input.aimX = reader.read<int16_t>();
+        input.aimY = reader.read<int16_t>();
+        input.flags = reader.read<uint8_t>();
+
+        // Only the next frame counts, older ones are repeats and a gap comes again in a later packet
+        const int f = first + i;
+        if (f != remoteConfirmed + 1) continue;
+
+        NetInput& stored = inputAt(remotePlayer, f);
+
+        // Already simulated with a prediction that turned out wrong
+        if (f < frame && (stored.aimX != input.aimX || stored.aimY != input.aimY || stored.flags != input.flags))
+        {
+            rollbackFrom = (rollbackFrom < 0) ? f : std::min(rollbackFrom, f);
+        }
+
+        stored = input;
+        remoteConfirmed = f;
+    }
+}
+
+void RollbackSession::sendPacket(double now)
+{
+    unsigned char packet[Transport::maxDatagramSize];
+
+    if (state == State::Hosting)
+    {
+        ByteWriter sync(packet, sizeof(packet));
+        WriteHeader(sync, PacketType::Sync, matchId);
+        sync.write((int32_t)startLevel);
+        sync.write(startSeed);
+
+        transport.send(packet, sync.getSize(), now);
+    }
+
+    // Everything the peer has not acked, oldest first
+    const int first = peerAcked + 1;
+    const int count = std::min(std::max(localLast - peerAcked, 0), maxInputsPerPacket);
+
+    ByteWriter writer(packet, sizeof(packet));
+    WriteHeader(writer, PacketType::Input, matchId);
+    writer.write((int32_t)remoteConfirmed);
+    writer.write((int32_t)first);
+    writer.write((uint8_t)count);
+    writer.write(now);
+    writer.write((peerSendTime >= 0.0) ? peerSendTime + (now - peerReceivedAt) : -1.0);
+
+    for (int i = 0; i < count; i++)
+    {
+        const NetInput& input = inputAt(localPlayer, first + i);
+        writer.write(input.aimX);
+        writer.write(input.aimY);
+        writer.write(input.flags);
+    }
+
+    transport.send(packet, writer.getSize(), now);
+}
+
+void RollbackSession::updateWindow(double now)
+{
+    if (windowStart < 0.0) windowStart = now;
+
+    if (now - windowStart >= 1.0)
+    {
+        stats.resimulatedPerSecond = (float)(windowResimulated / (now - windowStart));
+        windowStart = now;
+        windowResimulated = 0;
+    }
+}
+
+#pragma region GETTERS AND SETTERS
+
+void RollbackSession::setInputDelay(int frames)
+{
+    settings.inputDelay = std::min(std::max(frames, 0), maxInputDelay);
+}
+
+int RollbackSession::getInputDelay() const
+{
+    return settings.inputDelay;
+}
+
+int RollbackSession::getRecommendedDelay() const
+{
+    return std::min((int)ceil(stats.roundTrip * 0.5 / settings.step), maxInputDelay);
+}
+
+bool RollbackSession::isRunning() const
+{
+    return state == State::Hosting || state == State::Running;
+}
+
+bool RollbackSession::isWaiting() const
+{
+    return state == State::Hosting || state == State::Joining;
+}
+
+bool RollbackSession::isConfirmed() const
+{
+    return isRunning() && remoteConfirmed >= frame - 1;
+}
+
+int RollbackSession::getFrame() const
+{
+    return frame;
+}
+
+int RollbackSession::getLocalPlayer() const
+{
+    return localPlayer;
+}
+
+double RollbackSession::getSilence(double now) const
+{
+    return now - lastReceived;
+}
+
+const RollbackStats& RollbackSession::getStats() const
+{
+    return stats;
+}
+
+#pragma endregion
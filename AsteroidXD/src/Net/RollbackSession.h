@@ -0,0 +1,195 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Transport.h"
+#include "Simulation/Simulation.h"
+
+class ByteReader;
+
+/// <summary>
+/// Parametros de la sesion, los dos pares pueden usar distintos
+/// </summary>
+struct RollbackSettings
+{
+    // Frames the local input waits before it is used. Each frame of delay hides one frame
+    // of latency without rolling back, at the cost of a less responsive ship
+    int inputDelay = 2;
+
+    // Frames the prediction can run ahead of the last confirmed remote input.
+    // It is also the amount of snapshots kept, past it the session waits for the peer
+    int maxRollback = 8;
+
+    float step = 1.0f / 120.0f;
+};
+
+/// <summary>
+/// Contadores de la sesion, los tiempos son del reloj que recibe advance()
+/// </summary>
+struct RollbackStats
+{
+    unsigned long long frames = 0;
+    unsigned long long rollbacks = 0;
+    unsigned long long resimulatedFrames = 0;
+
+    // Frames that could not advance because the peer was too far behind
+    unsigned long long stalls = 0;
+
+    int lastRollbackDepth = 0;
+    int maxRollbackDepth = 0;
+
+    // Resimulated frames over the last full second
+    float resimulatedPerSecond = 0.0f;
+
+    // Seconds, smoothed
+    double roundTrip = 0.0;
+};
+
+/// <summary>
+/// Cooperativo de dos jugadores con rollback sobre una Simulation determinista.
+/// Cada frame se simula enseguida con la entrada local y la remota predicha (la ultima conocida, sin disparo);
+/// cuando llega la remota real y no coincide, se vuelve al snapshot de ese frame y se resimula hasta el actual.
+/// Los paquetes repiten las entradas que el par todavia no confirmo, asi una perdida no necesita reenvios.
+/// </summary>
+class RollbackSession
+{
+private:
+    // Input of one frame as it goes on the wire, aim in whole pixels so both peers use the same floats
+    struct NetInput
+    {
+        int16_t aimX;
+        int16_t aimY;
+        uint8_t flags;
+    };
+
+    enum class State
+    {
+        Idle,
+        Hosting,
+        Joining,
+        Running
+    };
+
+    // Frames of input kept per player, more than the peers can ever be apart
+    static const int historySize = 128;
+
+    Simulation& simulation;
+    Transport& transport;
+    RollbackSettings settings;
+    int localPlayer;
+    State state = State::Idle;
+    uint32_t matchId = 0;
+    int startLevel = 1;
+    uint64_t startSeed = 0;
+
+    // Next frame to simulate
+    int frame = 0;
+
+    // Last frame of local input and last frame whose remote input, and every one before it, arrived
+    int localLast = -1;
+    int remoteConfirmed = -1;
+
+    // Last local frame the peer says it has
+    int peerAcked = -1;
+    int rollbackFrom = -1;
+
+    std::vector<NetInput> inputs[Simulation::maxPlayers];
+
+    // Snapshot of the state before each of the last maxRollback + 2 frames
+    std::vector<std::vector<unsigned char>> snapshots;
+    std::vector<size_t> snapshotSizes;
+
+    double peerSendTime = -1.0;
+    double peerReceivedAt = 0.0;
+    double lastReceived = 0.0;
+    double windowStart = -1.0;
+    unsigned long long windowResimulated = 0;
+    RollbackStats stats;
+
+private:
+    void begin(int level, uint64_t seed);
+    void receivePackets(double now);
+    void handleInputs(ByteReader& reader, double now);
+    void rollback();
+    void simulateFrame();
+    void sendPacket(double now);
+    void updateWindow(double now);
+
+    NetInput& inputAt(int player, int index);
+    NetInput quantize(const SimInput& input) const;
+    SimInput toSimInput(int player, const NetInput& input) const;
+
+public:
+    /// <summary>
+    /// La simulacion tiene que estar configurada para dos jugadores, la sesion la reinicia al empezar cada partida
+    /// </summary>
+    /// <param name="simulation"></param>
+    /// <param name="transport"></param>
+    /// <param name="localPlayer">0 el anfitrion, 1 el invitado</param>
+    /// <param name="settings"></param>
+    RollbackSession(Simulation& simulation, Transport& transport, int localPlayer, const RollbackSettings& settings = RollbackSettings{});
+
+    /// <summary>
+    /// Anfitrion: empieza una partida y la anuncia hasta que el invitado responde.
+    /// Cada llamada es una partida nueva, el invitado sigue a la ultima.
+    /// </summary>
+    /// <param name="level"></param>
+    /// <param name="seed"></param>
+    void host(int level, uint64_t seed);
+
+    /// <summary>
+    /// Invitado: espera el anuncio del anfitrion y empieza con su nivel y su semilla
+    /// </summary>
+    void join();
+
+    void stop();
+
+    /// <summary>
+    /// Recibe, corrige lo que haga falta y simula un frame con la entrada local.
+    /// Los eventos de la simulacion son los del frame nuevo solo si devuelve true.
+    /// </summary>
+    /// <param name="localInput"></param>
+    /// <param name="now">Reloj del llamador en segundos</param>
+    /// <returns>true si simulo un frame, false si espera al par</returns>
+    bool advance(const SimInput& localInput, double now);
+
+    /// <summary>
+    /// Recibe, corrige y envia sin simular un frame nuevo
+    /// </summary>
+    /// <param name="now"></param>
+    void poll(double now);
+
+    /// <summary>
+    /// Cambia la demora de la entrada local. Al subirla se repite la ultima entrada,
+    /// al bajarla se descartan las entradas hasta alcanzar la nueva demora.
+    /// </summary>
+    /// <param name="frames"></param>
+    void setInputDelay(int frames);
+    int getInputDelay() const;
+
+    /// <summary>
+    /// Demora que cubre la mitad del tiempo de ida y vuelta medido, con ella casi no hay rollbacks
+    /// </summary>
+    /// <returns></returns>
+    int getRecommendedDelay() const;
+
+    bool isRunning() const;
+    bool isWaiting() const;
+
+    /// <summary>
+    /// Todas las entradas hasta el frame actual son reales, el estado ya no puede cambiar
+    /// </summary>
+    /// <returns></returns>
+    bool isConfirmed() const;
+
+    int getFrame() const;
+    int getLocalPlayer() const;
+
+    /// <summary>
+    /// Segundos desde el ultimo paquete del par
+    /// </summary>
+    /// <param name="now"></param>
+    /// <returns></returns>
+    double getSilence(double now) const;
+
+    const RollbackStats& getStats() const;
+};
@@ -0,0 +1,154 @@
+#include "StateClient.h"
+#include <algorithm>
+#include <cmath>
+#include "Utils/ByteStream.h"
+
+static const NetFrame emptyFrame{ };
+
+StateClient::StateClient(const SimConfig& config, Transport& transport, float step) :
+    codec(config, step),
+    transport(transport)
+{
+}
+
+void StateClient::update(const SimInput& input, double now)
+{
+    receivePackets(now);
+
+    unsigned char packet[stateInputPacketSize];
+    ByteWriter writer(packet, sizeof(packet));
+
+    for (char c : statePacketMagic) writer.write(c);
+    writer.write((uint8_t)StatePacketType::Input);
+    writer.write(++sequence);
+    writer.write(latestTick);
+
+    // Whole pixels, like the inputs of the rollback session
+    writer.write((int16_t)std::min(std::max(lroundf(input.aim.x), -32768L), 32767L));
+    writer.write((int16_t)std::min(std::max(lroundf(input.aim.y), -32768L), 32767L));
+    writer.write((uint8_t)(stateAimFlag | (input.thrust ? stateThrustFlag : 0) | (input.fire ? stateFireFlag : 0)));
+
+    transport.send(packet, writer.getSize(), now);
+}
+
+void StateClient::receivePackets(double now)
+{
+    unsigned char packet[Transport::maxDatagramSize];
+    size_t size;
+
+    while ((size = transport.receive(packet, sizeof(packet), now)) > 0)
+    {
+        stats.packetsReceived++;
+        stats.bytesReceived += size;
+
+        handlePart(packet, size);
+    }
+}
+
+void StateClient::handlePart(const unsigned char* packet, size_t size)
+{
+    if (size < stateFrameHeaderSize) return;
+
+    ByteReader reader(packet, size);
+    bool valid = true;
+
+    for (char c : statePacketMagic) valid = valid && reader.read<char>() == c;
+    if (!valid || (StatePacketType)reader.read<uint8_t>() != StatePacketType::Frame) return;
+
+    const int32_t tick = reader.read<int32_t>();
+    const int32_t baseline = reader.read<int32_t>();
+    const int part = reader.read<uint8_t>();
+    const int partCount = reader.read<uint8_t>();
+
+    if (partCount == 0 || partCount > StateCodec::maxParts || part >= partCount) return;
+
+    // Late parts of a frame already built or replaced
+    if (tick <= latestTick || tick < pendingTick) return;
+
+    if (tick > pendingTick)
+    {
+        // The frame in progress lost a part, a newer one takes its place
+        if (pendingTick >= 0) stats.framesDropped++;
+
+        pendingTick = tick;
+        pendingBaseline = baseline;
+        pendingParts = partCount;
+        pendingReceived = 0;
+
+        if (partData.size() < (size_t)partCount * Transport::maxDatagramSize) partData.resize((size_t)partCount * Transport::maxDatagramSize);
+        partSizes.assign(partCount, 0);
+    }
+
+    if (baseline != pendingBaseline || partCount != pendingParts || partSizes[part] > 0) return;
+
+    const size_t payload = size - stateFrameHeaderSize;
+    if (payload == 0) return;
+
+    memcpy(partData.data() + (size_t)part * Transport::maxDatagramSize, packet + stateFrameHeaderSize, payload);
+    partSizes[part] = payload;
+
+    if (++pendingReceived == pendingParts) assemble();
+}
+
+void StateClient::assemble()
+{
+    const int32_t tick = pendingTick;
+    pendingTick = -1;
+
+    const NetFrame* baseline = &emptyFrame;
+
+    if (pendingBaseline >= 0)
+    {
+        const NetFrame& stored = frames[pendingBaseline % MatchServer::frameHistory];
+
+        if (stored.tick != pendingBaseline)
+        {
+            stats.framesDropped++;
+            return;
+        }
+
+        baseline = &stored;
+    }
+
+    // The server never deltas against a frame frameHistory ticks old, so this is another slot than the baseline
+    NetFrame& frame = frames[tick % MatchServer::frameHistory];
+    if (&frame != baseline) frame = *baseline;
+
+    for (int part = 0; part < pendingParts; part++)
+    {
+        if (!codec.decodePart(partData.data() + (size_t)part * Transport::maxDatagramSize, partSizes[part], tick, frame))
+        {
+            frame.tick = -1;
+            stats.framesDropped++;
+            return;
+        }
+    }
+
+    frame.tick = tick;
+    latestTick = tick;
+    stats.framesReceived++;
+}
+
+#pragma region GETTERS
+
+bool StateClient::hasFrame() const
+{
+    return latestTick >= 0;
+}
+
+const NetFrame& StateClient::getFrame() const
+{
+    return frames[std::max(latestTick, 0) % MatchServer::frameHistory];
+}
+
+const StateCodec& StateClient::getCodec() const
+{
+    return codec;
+}
+
+const ClientStats& StateClient::getStats() const
+{
+    return stats;
+}
+
+#pragma endregion
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "MatchServer.h"
+
+/// <summary>
+/// Contadores del cliente desde que se creo
+/// </summary>
+struct ClientStats
+{
+    unsigned long long framesReceived = 0;
+
+    // Frames with a part lost or a baseline already gone, the next one that arrives replaces them
+    unsigned long long framesDropped = 0;
+
+    unsigned long long packetsReceived = 0;
+    unsigned long long bytesReceived = 0;
+};
+
+/// <summary>
+/// Cliente de MatchServer: junta las partes de cada frame, les aplica la diferencia sobre
+/// el frame base que ya tenia y confirma el ultimo que armo, junto con su entrada.
+/// No simula nada, dibuja lo que manda el servidor.
+/// </summary>
+class StateClient
+{
+private:
+    StateCodec codec;
+    Transport& transport;
+
+    // Frames built, the server uses any of them as baseline
+    NetFrame frames[MatchServer::frameHistory];
+    int32_t latestTick = -1;
+
+    // Frame being put together, its parts arrive in any order
+    int32_t pendingTick = -1;
+    int32_t pendingBaseline = -1;
+    int pendingParts = 0;
+    int pendingReceived = 0;
+    std::vector<unsigned char> partData;
+    std::vector<size_t> partSizes;
+
+    uint32_t sequence = 0;
+    ClientStats stats;
+
+private:
+    void receivePackets(double now);
+    void handlePart(const unsigned char* packet, size_t size);
+    void assemble();
+
+public:
+    /// <summary>
+    /// La configuracion y el tick tienen que ser los del servidor
+    /// </summary>
+    /// <param name="config"></param>
+    /// <param name="transport"></param>
+    /// <param name="step">ServerSettings::step del servidor</param>
+    StateClient(const SimConfig& config, Transport& transport, float step = 1.0f / 120.0f);
+
+    /// <summary>
+    /// Recibe lo que llego y envia la entrada con la confirmacion del ultimo frame
+    /// </summary>
+    /// <param name="input"></param>
+    /// <param name="now">Reloj del llamador en segundos</param>
+    void update(const SimInput& input, double now);
+
+    bool hasFrame() const;
+
+    /// <summary>
+    /// Ultimo frame completo, solo es valido con hasFrame
+    /// </summary>
+    /// <returns></returns>
+    const NetFrame& getFrame() const;
+
+    const StateCodec& getCodec() const;
+    const ClientStats& getStats() const;
+};
@@ -0,0 +1,506 @@
+#include "StateCodec.h"
+#include <algorithm>
+#include <cmath>
+#include "Utils/BitStream.h"
+
+// Eighths of a pixel, finer than anything the renderer can show
+static const float positionScale = 8.0f;
+
+// Speeds in sixteenths of a position unit per tick, the prediction is exact to a unit for the whole history
+static const int speedShift = 4;
+
+// Error of a coordinate against its prediction: none, within a pixel, within 16 pixels or the whole coordinate
+static const int nearBits = 4;
+static const int farBits = 8;
+
+// Ships and shots need a finer angle than the sprites that only spin
+static const int shipRotationBits = 10;
+static const int shootRotationBits = 10;
+static const int spriteRotationBits = 8;
+
+// Slots covered by one part, a reserved field filled once the part is full
+static const int spanBits = 16;
+static const int maxSpan = (1 << spanBits) - 1;
+
+// Limits for a decoded count, beyond them the part is garbage
+static const uint32_t maxSlots = 1 << 22;
+
+#pragma region HELPERS
+
+// Bits that hold every value in [0, value]
+static int BitsFor(uint32_t value)
+{
+    int bits = 1;
+    while (bits < 32 && (value >> bits) != 0) bits++;
+
+    return bits;
+}
+
+static uint16_t QuantizeAngle(float degrees, int bits)
+{
+    const float turns = degrees / 360.0f;
+    const float fraction = turns - floorf(turns);
+
+    return (uint16_t)(lroundf(fraction * (float)(1 << bits)) & ((1 << bits) - 1));
+}
+
+static void WriteVarint(BitWriter& writer, uint32_t value)
+{
+    // Seven bits at a time, the eighth says whether more follow
+    do
+    {
+        const uint32_t group = value & 127;
+        value >>= 7;
+        writer.write(group | (value != 0 ? 128 : 0), 8);
+    } while (value != 0);
+}
+
+static uint32_t ReadVarint(BitReader& reader)
+{
+    uint32_t value = 0;
+
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        const uint32_t group = reader.read(8);
+        value |= (group & 127) << shift;
+
+        if ((group & 128) == 0 || reader.hasFailed()) break;
+    }
+
+    return value;
+}
+
+// A field that goes only when it changed: one bit, plus the value if it did
+static void WriteField(BitWriter& writer, uint32_t value, uint32_t base, int bits)
+{
+    writer.writeBool(value != base);
+    if (value != base) writer.write(value, bits);
+}
+
+static uint32_t ReadField(BitReader& reader, uint32_t base, int bits)
+{
+    return reader.readBool() ? reader.read(bits) : base;
+}
+
+#pragma endregion
+
+StateCodec::StateCodec(const SimConfig& config, float step) :
+    config(config),
+    step(step)
+{
+    // Everything wraps once it is a radius past the border, plus what it can move in one tick
+    margin = std::max(config.bigMeteorRadius, config.shipRadius) + 16.0f;
+
+    coordinateBits[0] = BitsFor((uint32_t)ceilf((config.width + margin * 2.0f) * positionScale));
+    coordinateBits[1] = BitsFor((uint32_t)ceilf((config.height + margin * 2.0f) * positionScale));
+    shieldBits = BitsFor((uint32_t)std::max(config.shipMaxShield, 1));
+    tierBits = BitsFor((uint32_t)std::max(config.meteorTiers - 1, 1));
+    ownerBits = BitsFor(Simulation::maxPlayers - 1);
+}
+
+#pragma region QUANTIZATION
+
+uint16_t StateCodec::quantizeCoordinate(float value, int axis) const
+{
+    const long maxValue = std::min((1L << coordinateBits[axis]) - 1, 65535L);
+    const long quantized = lroundf((value + margin) * positionScale);
+
+    return (uint16_t)std::min(std::max(quantized, 0L), maxValue);
+}
+
+int16_t StateCodec::quantizeSpeed(float speed) const
+{
+    const long quantized = lroundf(speed * step * positionScale * (float)(1 << speedShift));
+
+    return (int16_t)std::min(std::max(quantized, -32768L), 32767L);
+}
+
+uint16_t StateCodec::predict(uint16_t base, int16_t speed, int ticks, int axis) const
+{
+    // Integers only, rounded half away from zero, so the client predicts exactly what the server did
+    const long long moved = (long long)speed * ticks;
+    const long long half = 1LL << (speedShift - 1);
+    const long long offset = (moved >= 0) ? (moved + half) >> speedShift : -((-moved + half) >> speedShift);
+
+    const long long maxValue = std::min((1LL << coordinateBits[axis]) - 1, 65535LL);
+
+    return (uint16_t)std::min(std::max(base + offset, 0LL), maxValue);
+}
+
+Vector2 StateCodec::toPosition(uint16_t x, uint16_t y) const
+{
+    return Vector2{ x / positionScale - margin, y / positionScale - margin };
+}
+
+void StateCodec::capture(const Simulation& simulation, int32_t tick, NetFrame& frame) const
+{
+    frame.tick = tick;
+    frame.level = simulation.getLevel();
+    frame.gameOver = simulation.isGameOver();
+    frame.victory = simulation.isVictory();
+
+    frame.ships.resize(simulation.getPlayerCount());
+
+    for (int i = 0; i < simulation.getPlayerCount(); i++)
+    {
+        const ShipState& ship = simulation.getShip(i);
+        NetShip& net = frame.ships[i];
+
+        net.x = quantizeCoordinate(ship.position.x, 0);
+        net.y = quantizeCoordinate(ship.position.y, 1);
+        net.rotation = QuantizeAngle(ship.rotation, shipRotationBits);
+        net.shield = (uint16_t)std::min(std::max(ship.shield, 0), config.shipMaxShield);
+    }
+
+    const PowerUpState& powerUp = simulation.getPowerUp();
+    frame.powerUp = NetPowerUp{ };
+
+    if (powerUp.active)
+    {
+        frame.powerUp.x = quantizeCoordinate(powerUp.position.x, 0);
+        frame.powerUp.y = quantizeCoordinate(powerUp.position.y, 1);
+        frame.powerUp.rotation = (uint8_t)QuantizeAngle(powerUp.rotation, spriteRotationBits);
+        frame.powerUp.active = true;
+    }
+
+    const MeteorField& meteors = simulation.getMeteors();
+    frame.meteors.resize(meteors.size());
+
+    for (int i = 0; i < meteors.size(); i++)
+    {
+        NetMeteor& net = frame.meteors[i];
+        net = NetMeteor{ };
+
+        if (!meteors.active[i]) continue;
+
+        net.x = quantizeCoordinate(meteors.positionX[i], 0);
+        net.y = quantizeCoordinate(meteors.positionY[i], 1);
+        net.speedX = quantizeSpeed(meteors.speedX[i]);
+        net.speedY = quantizeSpeed(meteors.speedY[i]);
+        net.rotation = (uint8_t)QuantizeAngle(meteors.rotation[i], spriteRotationBits);
+        net.tier = meteors.tier[i];
+        net.active = true;
+    }
+
+    const Pool<ShootState>& shoots = simulation.getShoots();
+    frame.shoots.resize(shoots.getCapacity());
+
+    for (int i = 0; i < shoots.getCapacity(); i++)
+    {
+        NetShoot& net = frame.shoots[i];
+        net = NetShoot{ };
+
+        if (!shoots.isActive(i)) continue;
+
+        const ShootState& shoot = shoots[i];
+        net.x = quantizeCoordinate(shoot.position.x, 0);
+        net.y = quantizeCoordinate(shoot.position.y, 1);
+
+        // Shots move up with a positive speed.y
+        net.speedX = quantizeSpeed(shoot.speed.x);
+        net.speedY = quantizeSpeed(-shoot.speed.y);
+        net.rotation = QuantizeAngle(shoot.rotation, shootRotationBits);
+        net.owner = (uint8_t)shoot.owner;
+        net.active = true;
+    }
+}
+
+#pragma endregion
+
+#pragma region ENCODING
+
+void StateCodec::writeCoordinate(BitWriter& writer, uint16_t value, uint16_t predicted, int axis) const
+{
+    const int error = (int)value - (int)predicted;
+
+    writer.writeBool(error != 0);
+    if (error == 0) return;
+
+    const bool near = error >= -(1 << (nearBits - 1)) && error < (1 << (nearBits - 1));
+    writer.writeBool(!near);
+
+    if (near)
+    {
+        writer.write((uint32_t)(error + (1 << (nearBits - 1))), nearBits);
+        return;
+    }
+
+    const bool far = error >= -(1 << (farBits - 1)) && error < (1 << (farBits - 1));
+    writer.writeBool(!far);
+
+    if (far) writer.write((uint32_t)(error + (1 << (farBits - 1))), farBits);
+    else writer.write(value, coordinateBits[axis]);
+}
+
+uint16_t StateCodec::readCoordinate(BitReader& reader, uint16_t predicted, int axis) const
+{
+    if (!reader.readBool()) return predicted;
+
+    if (!reader.readBool()) return (uint16_t)((int)predicted + (int)reader.read(nearBits) - (1 << (nearBits - 1)));
+
+    if (!reader.readBool()) return (uint16_t)((int)predicted + (int)reader.read(farBits) - (1 << (farBits - 1)));
+
+    return (uint16_t)reader.read(coordinateBits[axis]);
+}
+
+void StateCodec::writeGlobal(BitWriter& writer, const NetFrame& frame, const NetFrame& baseline) const
+{
+    WriteVarint(writer, (uint32_t)frame.level);
+    writer.writeBool(frame.gameOver);
+    writer.writeBool(frame.victory);
+
+    WriteVarint(writer, (uint32_t)frame.ships.size());
+
+    for (size_t i = 0; i < frame.ships.size(); i++)
+    {
+        const NetShip& ship = frame.ships[i];
+        const NetShip base = (i < baseline.ships.size()) ? baseline.ships[i] : NetShip{ };
+
+        writer.writeBool(ship != base);
+        if (ship == base) continue;
+
+        writeCoordinate(writer, ship.x, base.x, 0);
+        writeCoordinate(writer, ship.y, base.y, 1);
+        WriteField(writer, ship.rotation, base.rotation, shipRotationBits);
+        WriteField(writer, ship.shield, base.shield, shieldBits);
+    }
+
+    const NetPowerUp& powerUp = frame.powerUp;
+    const NetPowerUp& base = baseline.powerUp;
+
+    writer.writeBool(powerUp != base);
+
+    if (powerUp != base)
+    {
+        writer.writeBool(powerUp.active);
+
+        if (powerUp.active)
+        {
+            writeCoordinate(writer, powerUp.x, base.x, 0);
+            writeCoordinate(writer, powerUp.y, base.y, 1);
+            WriteField(writer, powerUp.rotation, base.rotation, spriteRotationBits);
+        }
+    }
+
+    WriteVarint(writer, (uint32_t)frame.meteors.size());
+    WriteVarint(writer, (uint32_t)frame.shoots.size());
+}
+
+bool StateCodec::readGlobal(BitReader& reader, NetFrame& frame) const
+{
+    frame.level = (int)ReadVarint(reader);
+    frame.gameOver = reader.readBool();
+    frame.victory = reader.readBool();
+
+    const uint32_t shipCount = ReadVarint(reader);
+    if (shipCount > (uint32_t)Simulation::maxPlayers) return false;
+
+    frame.ships.resize(shipCount);
+
+    for (NetShip& ship : frame.ships)
+    {
+        if (!reader.readBool()) continue;
+
+        ship.x = readCoordinate(reader, ship.x, 0);
+        ship.y = readCoordinate(reader, ship.y, 1);
+        ship.rotation = (uint16_t)ReadField(reader, ship.rotation, shipRotationBits);
+        ship.shield = (uint16_t)ReadField(reader, ship.shield, shieldBits);
+    }
+
+    NetPowerUp& powerUp = frame.powerUp;
+
+    if (reader.readBool())
+    {
+        if (reader.readBool())
+        {
+            powerUp.x = readCoordinate(reader, powerUp.x, 0);
+            powerUp.y = readCoordinate(reader, powerUp.y, 1);
+            powerUp.rotation = (uint8_t)ReadField(reader, powerUp.rotation, spriteRotationBits);
+            powerUp.active = true;
+        }
+        else powerUp = NetPowerUp{ };
+    }
+
+    const uint32_t meteorCount = ReadVarint(reader);
+    const uint32_t shootCount = ReadVarint(reader);
+    if (reader.hasFailed() || meteorCount > maxSlots || shootCount > maxSlots) return false;
+
+    // New slots start inactive, the same the encoder assumes past the end of the baseline
+    frame.meteors.resize(meteorCount);
+    frame.shoots.resize(shootCount);
+
+    return true;
+}
+
+void StateCodec::writeMeteor(BitWriter& writer, const NetMeteor& meteor, const NetMeteor& base, int ticks) const
+{
+    writer.writeBool(meteor != base);
+    if (meteor == base) return;
+
+    writer.writeBool(meteor.active);
+    if (!meteor.active) return;
+
+    // The speed goes first, the prediction of a meteor that just spawned in the slot uses its own
+    WriteField(writer, (uint16_t)meteor.speedX, (uint16_t)base.speedX, 16);
+    WriteField(writer, (uint16_t)meteor.speedY, (uint16_t)base.speedY, 16);
+    writeCoordinate(writer, meteor.x, predict(base.x, base.speedX, ticks, 0), 0);
+    writeCoordinate(writer, meteor.y, predict(base.y, base.speedY, ticks, 1), 1);
+    WriteField(writer, meteor.rotation, base.rotation, spriteRotationBits);
+    WriteField(writer, meteor.tier, base.tier, tierBits);
+}
+
+void StateCodec::readMeteor(BitReader& reader, NetMeteor& meteor, int ticks) const
+{
+    if (!reader.readBool()) return;
+
+    if (!reader.readBool())
+    {
+        meteor = NetMeteor{ };
+        return;
+    }
+
+    const NetMeteor base = meteor;
+    meteor.speedX = (int16_t)ReadField(reader, (uint16_t)base.speedX, 16);
+    meteor.speedY = (int16_t)ReadField(reader, (uint16_t)base.speedY, 16);
+    meteor.x = readCoordinate(reader, predict(base.x, base.speedX, ticks, 0), 0);
+    meteor.y = readCoordinate(reader, predict(base.y, base.speedY, ticks, 1), 1);
+    meteor.rotation = (uint8_t)ReadField(reader, meteor.rotation, spriteRotationBits);
+    meteor.tier = (uint8_t)ReadField(reader, meteor.tier, tierBits);
+    meteor.active = true;
+}
+
+void StateCodec::writeShoot(BitWriter& writer, const NetShoot& shoot, const NetShoot& base, int ticks) const
+{
+    writer.writeBool(shoot != base);
+    if (shoot == base) return;
+
+    writer.writeBool(shoot.active);
+    if (!shoot.active) return;
+
+    WriteField(writer, (uint16_t)shoot.speedX, (uint16_t)base.speedX, 16);
+    WriteField(writer, (uint16_t)shoot.speedY, (uint16_t)base.speedY, 16);
+    writeCoordinate(writer, shoot.x, predict(base.x, base.speedX, ticks, 0), 0);
+    writeCoordinate(writer, shoot.y, predict(base.y, base.speedY, ticks, 1), 1);
+    WriteField(writer, shoot.rotation, base.rotation, shootRotationBits);
+    WriteField(writer, shoot.owner, base.owner, ownerBits);
+}
+
+void StateCodec::readShoot(BitReader& reader, NetShoot& shoot, int ticks) const
+{
+    if (!reader.readBool()) return;
+
+    if (!reader.readBool())
+    {
+        shoot = NetShoot{ };
+        return;
+    }
+
+    const NetShoot base = shoot;
+    shoot.speedX = (int16_t)ReadField(reader, (uint16_t)base.speedX, 16);
+    shoot.speedY = (int16_t)ReadField(reader, (uint16_t)base.speedY, 16);
+    shoot.x = readCoordinate(reader, predict(base.x, base.speedX, ticks, 0), 0);
+    shoot.y = readCoordinate(reader, predict(base.y, base.speedY, ticks, 1), 1);
+    shoot.rotation = (uint16_t)ReadField(reader, shoot.rotation, shootRotationBits);
+    shoot.owner = (uint8_t)ReadField(reader, shoot.owner, ownerBits);
+    shoot.active = true;
+}
+
+bool StateCodec::encode(const NetFrame& frame, const NetFrame& baseline, size_t partCapacity, EncodedFrame& encoded) const
+{
+    encoded.bytes.clear();
+    encoded.partEnds.clear();
+    encoded.baselineTick = baseline.tick;
+
+    // Meteors and then shots, as one run of items the parts split between them
+    const int meteorCount = (int)frame.meteors.size();
+    const int itemCount = meteorCount + (int)frame.shoots.size();
+    const NetMeteor noMeteor{ };
+    const NetShoot noShoot{ };
+    const int ticks = frame.tick - baseline.tick;
+
+    int item = 0;
+    bool global = true;
+
+    while (global || item < itemCount)
+    {
+        if (encoded.getPartCount() == maxParts) return false;
+
+        const size_t start = encoded.bytes.size();
+        encoded.bytes.resize(start + partCapacity);
+
+        BitWriter writer(encoded.bytes.data() + start, partCapacity);
+        writer.writeBool(global);
+        if (global) writeGlobal(writer, frame, baseline);
+
+        WriteVarint(writer, (uint32_t)item);
+        const size_t spanAt = writer.getPosition();
+        writer.write(0, spanBits);
+
+        if (writer.hasOverflow()) return false;
+
+        int span = 0;
+
+        while (item < itemCount && span < maxSpan)
+        {
+            const size_t mark = writer.getPosition();
+
+            if (item < meteorCount)
+            {
+                writeMeteor(writer, frame.meteors[item], item < (int)baseline.meteors.size() ? baseline.meteors[item] : noMeteor, ticks);
+            }
+            else
+            {
+                const int shoot = item - meteorCount;
+                writeShoot(writer, frame.shoots[shoot], shoot < (int)baseline.shoots.size() ? baseline.shoots[shoot] : noShoot, ticks);
+            }
+
+            // Goes first in the next part
+            if (writer.hasOverflow())
+            {
+                writer.rewind(mark);
+                break;
+            }
+
+            item++;
+            span++;
+        }
+
+        // Not even one item fits in an empty part
+        if (span == 0 && !global) return false;
+
+        writer.overwrite(spanAt, (uint32_t)span, spanBits);
+        global = false;
+
+        encoded.bytes.resize(start + writer.getSize());
+        encoded.partEnds.push_back(encoded.bytes.size());
+    }
+
+    return true;
+}
+
+bool StateCodec::decodePart(const void* data, size_t size, int32_t tick, NetFrame& frame) const
+{
+    const int ticks = tick - frame.tick;
+
+    BitReader reader(data, size);
+
+    if (reader.readBool() && !readGlobal(reader, frame)) return false;
+
+    const uint32_t first = ReadVarint(reader);
+    const uint32_t span = reader.read(spanBits);
+
+    const uint32_t meteorCount = (uint32_t)frame.meteors.size();
+    const uint32_t itemCount = meteorCount + (uint32_t)frame.shoots.size();
+
+    if (reader.hasFailed() || first > itemCount || span > itemCount - first) return false;
+
+    for (uint32_t item = first; item < first + span; item++)
+    {
+        if (item < meteorCount) readMeteor(reader, frame.meteors[item], ticks);
+        else readShoot(reader, frame.shoots[item - meteorCount], ticks);
+    }
+
+    return !reader.hasFailed();
+}
+
+#pragma endregion
@@ -0,0 +1,198 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Simulation/Simulation.h"
+
+class BitWriter;
+class BitReader;
+
+#pragma region NET FRAME
+
+// Positions are fixed point over the playfield plus a margin, rotations a fraction of a turn.
+// Speeds are in sixteenths of a position unit per tick, meteors and shots keep theirs for life.
+// Inactive entries are all zeros, so two frames are equal exactly when they draw the same.
+
+struct NetShip
+{
+    uint16_t x = 0;
+    uint16_t y = 0;
+    uint16_t rotation = 0;
+    uint16_t shield = 0;
+};
+
+struct NetPowerUp
+{
+    uint16_t x = 0;
+    uint16_t y = 0;
+    uint8_t rotation = 0;
+    bool active = false;
+};
+
+struct NetMeteor
+{
+    uint16_t x = 0;
+    uint16_t y = 0;
+    int16_t speedX = 0;
+    int16_t speedY = 0;
+    uint8_t rotation = 0;
+    uint8_t tier = 0;
+    bool active = false;
+};
+
+struct NetShoot
+{
+    uint16_t x = 0;
+    uint16_t y = 0;
+    int16_t speedX = 0;
+    int16_t speedY = 0;
+    uint16_t rotation = 0;
+    uint8_t owner = 0;
+    bool active = false;
+};
+
+/// <summary>
+/// Lo que un cliente necesita para dibujar un tick de una partida, cuantizado.
+/// Meteoros y disparos van por slot, asi un slot sin cambios no se envia.
+/// </summary>
+struct NetFrame
+{
+    // Tick of the server, -1 is the empty frame the first delta starts from
+    int32_t tick = -1;
+    int level = 0;
+    bool gameOver = false;
+    bool victory = false;
+
+    std::vector<NetShip> ships;
+    NetPowerUp powerUp;
+    std::vector<NetMeteor> meteors;
+    std::vector<NetShoot> shoots;
+};
+
+inline bool operator==(const NetShip& a, const NetShip& b)
+{
+    return a.x == b.x && a.y == b.y && a.rotation == b.rotation && a.shield == b.shield;
+}
+
+inline bool operator==(const NetPowerUp& a, const NetPowerUp& b)
+{
+    return a.active == b.active && a.x == b.x && a.y == b.y && a.rotation == b.rotation;
+}
+
+inline bool operator==(const NetMeteor& a, const NetMeteor& b)
+{
+    return a.active == b.active && a.x == b.x && a.y == b.y && a.speedX == b.speedX && a.speedY == b.speedY
+        && a.rotation == b.rotation && a.tier == b.tier;
+}
+
+inline bool operator==(const NetShoot& a, const NetShoot& b)
+{
+    return a.active == b.active && a.x == b.x && a.y == b.y && a.speedX == b.speedX && a.speedY == b.speedY
+        && a.rotation == b.rotation && a.owner == b.owner;
+}
+
+inline bool operator!=(const NetShip& a, const NetShip& b) { return !(a == b); }
+inline bool operator!=(const NetPowerUp& a, const NetPowerUp& b) { return !(a == b); }
+inline bool operator!=(const NetMeteor& a, const NetMeteor& b) { return !(a == b); }
+inline bool operator!=(const NetShoot& a, const NetShoot& b) { return !(a == b); }
+
+/// <summary>
+/// Un frame codificado contra una base, partido en datagramas.
+/// Los vectores se reutilizan de un tick al siguiente.
+/// </summary>
+struct EncodedFrame
+{
+    // Payloads one after the other, part i is [partEnds[i - 1], partEnds[i])
+    std::vector<unsigned char> bytes;
+    std::vector<size_t> partEnds;
+    int32_t baselineTick = -1;
+
+    int getPartCount() const { return (int)partEnds.size(); }
+    const unsigned char* getPart(int part) const { return bytes.data() + (part > 0 ? partEnds[part - 1] : 0); }
+    size_t getPartSize(int part) const { return partEnds[part] - (part > 0 ? partEnds[part - 1] : 0); }
+};
+
+#pragma endregion
+
+/// <summary>
+/// Cuantiza el estado de una Simulation y lo codifica como diferencia contra un frame que el cliente ya tiene.
+/// Solo van los slots que cambiaron y, dentro de ellos, los campos que cambiaron, empaquetados en bits.
+/// La posicion de meteoros y disparos se predice con su velocidad desde la base y solo va el error,
+/// casi siempre unos pocos bits; las cuentas son enteras para que los dos lados predigan lo mismo.
+/// Servidor y cliente construyen el codec con la misma SimConfig y el mismo tick.
+/// </summary>
+class StateCodec
+{
+public:
+    // More parts than this and the frame is not sent, a level holds far fewer meteors
+    static const int maxParts = 64;
+
+private:
+    SimConfig config;
+    float step;
+    float margin;
+    int coordinateBits[2];
+    int shieldBits;
+    int tierBits;
+    int ownerBits;
+
+private:
+    uint16_t quantizeCoordinate(float value, int axis) const;
+    int16_t quantizeSpeed(float speed) const;
+    uint16_t predict(uint16_t base, int16_t speed, int ticks, int axis) const;
+    void writeCoordinate(BitWriter& writer, uint16_t value, uint16_t predicted, int axis) const;
+    uint16_t readCoordinate(BitReader& reader, uint16_t predicted, int axis) const;
+
+    void writeGlobal(BitWriter& writer, const NetFrame& frame, const NetFrame& baseline) const;
+    bool readGlobal(BitReader& reader, NetFrame& frame) const;
+    void writeMeteor(BitWriter& writer, const NetMeteor& meteor, const NetMeteor& base, int ticks) const;
+    void readMeteor(BitReader& reader, NetMeteor& meteor, int ticks) const;
+    void writeShoot(BitWriter& writer, const NetShoot& shoot, const NetShoot& base, int ticks) const;
+    void readShoot(BitReader& reader, NetShoot& shoot, int ticks) const;
+
+public:
+    /// <summary>
+    /// Servidor y cliente tienen que usar los mismos parametros
+    /// </summary>
+    /// <param name="config"></param>
+    /// <param name="step">Segundos por tick de la simulacion, para cuantizar las velocidades</param>
+    StateCodec(const SimConfig& config = SimConfig{}, float step = 1.0f / 120.0f);
+
+    /// <summary>
+    /// Cuantiza el estado actual de la simulacion, reutiliza los vectores de frame
+    /// </summary>
+    /// <param name="simulation"></param>
+    /// <param name="tick"></param>
+    /// <param name="frame"></param>
+    void capture(const Simulation& simulation, int32_t tick, NetFrame& frame) const;
+
+    /// <summary>
+    /// Codifica frame contra baseline en partes de hasta partCapacity bytes.
+    /// Con el frame vacio como base el resultado es el estado completo.
+    /// </summary>
+    /// <param name="frame"></param>
+    /// <param name="baseline">Frame que el cliente confirmo tener</param>
+    /// <param name="partCapacity"></param>
+    /// <param name="encoded"></param>
+    /// <returns>false si necesita mas de maxParts partes</returns>
+    bool encode(const NetFrame& frame, const NetFrame& baseline, size_t partCapacity, EncodedFrame& encoded) const;
+
+    /// <summary>
+    /// Aplica una parte de encode sobre frame, que empieza como una copia de la base con su tick.
+    /// Las partes se aplican en orden, la primera trae las cantidades de slots; despues se le pone el tick nuevo.
+    /// </summary>
+    /// <param name="data"></param>
+    /// <param name="size"></param>
+    /// <param name="tick">Tick del frame codificado</param>
+    /// <param name="frame"></param>
+    /// <returns>false si la parte esta truncada o no corresponde a frame</returns>
+    bool decodePart(const void* data, size_t size, int32_t tick, NetFrame& frame) const;
+
+    /// <summary>
+    /// Posicion en pixeles de una posicion cuantizada
+    /// </summary>
+    /// <param name="x"></param>
+    /// <param name="y"></param>
+    /// <returns></returns>
+    Vector2 toPosition(uint16_t x, uint16_t y) const;
+};
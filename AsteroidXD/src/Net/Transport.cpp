@@ -0,0 +1,89 @@
+#include "Transport.h"
+#include <cstring>
+
+// Stream of the loss and jitter draws, apart from the ones the simulation uses
+static const uint64_t conditionsStream = 7;
+
+void Transport::setConditions(const NetConditions& conditions, uint64_t seed)
+{
+    this->conditions = conditions;
+    random.seed(seed, conditionsStream);
+}
+
+const NetConditions& Transport::getConditions() const
+{
+    return conditions;
+}
+
+void Transport::send(const void* data, size_t size, double now)
+{
+    if (size == 0 || size > maxDatagramSize) return;
+
+    stats.sent++;
+    stats.bytesSent += size;
+
+    // Draws in [0, 1), the same seed loses the same datagrams
+    const float lossDraw = (float)(random.next() >> 8) / (float)(1 << 24);
+    const double jitterDraw = (double)(random.next() >> 8) / (double)(1 << 24);
+
+    if (lossDraw < conditions.loss)
+    {
+        stats.lost++;
+        return;
+    }
+
+    const double delay = conditions.latency + conditions.jitter * jitterDraw;
+
+    if (delay <= 0.0)
+    {
+        flush(now);
+        sendNow(data, size);
+        return;
+    }
+
+    Datagram datagram;
+    datagram.due = now + delay;
+    datagram.size = size;
+    memcpy(datagram.data, data, size);
+
+    delayed.push_back(datagram);
+}
+
+void Transport::flush(double now)
+{
+    // Few datagrams are in flight at once, a linear search for the earliest is enough
+    for (;;)
+    {
+        int next = -1;
+
+        for (int i = 0; i < (int)delayed.size(); i++)
+        {
+            if (delayed[i].due <= now && (next < 0 || delayed[i].due < delayed[next].due)) next = i;
+        }
+
+        if (next < 0) return;
+
+        sendNow(delayed[next].data, delayed[next].size);
+        delayed.erase(delayed.begin() + next);
+    }
+}
+
+size_t Transport::receive(void* buffer, size_t capacity, double now)
+{
+    flush(now);
+
+    const size_t size = receiveNow(buffer, capacity);
+
+    if (size > 0)
+    {
+        stats.received++;
+        stats.bytesReceived += size;
+    }
+
+    return size;
+}
+
+const TransportStats& Transport::getStats() const
+{
+    return stats;
+}
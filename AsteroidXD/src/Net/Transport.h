@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Simulation/Random.h"
+
+/// <summary>
+/// Red simulada del lado que envia: demora fija, variacion al azar y perdida.
+/// Con jitter los datagramas pueden llegar desordenados, como con UDP de verdad.
+/// </summary>
+struct NetConditions
+{
+    // Seconds
+    double latency = 0.0;
+    double jitter = 0.0;
+
+    // Fraction of the datagrams that never arrive [0, 1]
+    float loss = 0.0f;
+};
+
+/// <summary>
+/// Contadores desde que se abrio el transporte
+/// </summary>
+struct TransportStats
+{
+    unsigned int sent = 0;
+    unsigned int received = 0;
+    unsigned int lost = 0;
+    unsigned long long bytesSent = 0;
+    unsigned long long bytesReceived = 0;
+};
+
+/// <summary>
+/// Datagramas sin conexion entre dos pares, lo que necesita RollbackSession.
+/// Las condiciones de red se aplican aca, antes de entregarlos a la implementacion,
+/// asi el transporte en memoria y UDP se prueban con la misma latencia y perdida.
+/// </summary>
+class Transport
+{
+public:
+    // Bigger datagrams are dropped by send, the rollback packets never get close
+    static const size_t maxDatagramSize = 512;
+
+private:
+    struct Datagram
+    {
+        double due;
+        size_t size;
+        unsigned char data[maxDatagramSize];
+    };
+
+    NetConditions conditions;
+    Random random;
+    std::vector<Datagram> delayed;
+    TransportStats stats;
+
+    // Hands the datagrams whose delay ended to sendNow
+    void flush(double now);
+
+protected:
+    virtual bool sendNow(const void* data, size_t size) = 0;
+
+    /// <summary>
+    /// Proximo datagrama que llego, sin esperar
+    /// </summary>
+    /// <returns>Su tamaño, 0 si no hay ninguno</returns>
+    virtual size_t receiveNow(void* buffer, size_t capacity) = 0;
+
+public:
+    virtual ~Transport() = default;
+
+    /// <summary>
+    /// Condiciones de red de lo que envia este par, la semilla decide que datagramas se pierden
+    /// </summary>
+    /// <param name="conditions"></param>
+    /// <param name="seed"></param>
+    void setConditions(const NetConditions& conditions, uint64_t seed);
+    const NetConditions& getConditions() const;
+
+    /// <summary>
+    /// Envia un datagrama, puede perderse o llegar tarde segun las condiciones
+    /// </summary>
+    /// <param name="data"></param>
+    /// <param name="size"></param>
+    /// <param name="now">Reloj del llamador en segundos</param>
+    void send(const void* data, size_t size, double now);
+
+    /// <summary>
+    /// Proximo datagrama recibido. Tambien despacha los enviados cuya demora ya paso,
+    /// por eso se llama una vez por frame aunque no se espere nada.
+    /// </summary>
+    /// <param name="buffer"></param>
+    /// <param name="capacity"></param>
+    /// <param name="now">Reloj del llamador en segundos</param>
+    /// <returns>Tamaño del datagrama, 0 si no hay ninguno</returns>
+    size_t receive(void* buffer, size_t capacity, double now);
+
+    const TransportStats& getStats() const;
+};
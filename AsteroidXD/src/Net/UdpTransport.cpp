@@ -0,0 +1,142 @@
+#include "UdpTransport.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+typedef SOCKET SocketHandle;
+typedef int SocketLength;
+static const SocketHandle invalidSocket = INVALID_SOCKET;
+
+static void CloseSocket(SocketHandle socket) { closesocket(socket); }
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+typedef int SocketHandle;
+typedef socklen_t SocketLength;
+static const SocketHandle invalidSocket = -1;
+
+static void CloseSocket(SocketHandle socket) { ::close(socket); }
+#endif
+
+UdpTransport::~UdpTransport()
+{
+    close();
+}
+
+bool UdpTransport::open(uint16_t localPort, const char remoteHost[], uint16_t remotePort)
+{
+    close();
+
+#ifdef _WIN32
+    // Winsock counts the startups, close() balances this one
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) return false;
+#endif
+
+    in_addr address;
+
+    if (inet_pton(AF_INET, remoteHost, &address) != 1)
+    {
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    SocketHandle socket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(localPort);
+
+    bool opened = socket != invalidSocket && bind(socket, (const sockaddr*)&local, sizeof(local)) == 0;
+
+    // The game polls once per frame, it never waits on the socket
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    opened = opened && ioctlsocket(socket, FIONBIO, &nonBlocking) == 0;
+#else
+    opened = opened && fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+
+    if (!opened)
+    {
+        if (socket != invalidSocket) CloseSocket(socket);
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    handle = (intptr_t)socket;
+    remoteAddress = address.s_addr;
+    this->remotePort = htons(remotePort);
+
+    return true;
+}
+
+void UdpTransport::close()
+{
+    if (handle < 0) return;
+
+    CloseSocket((SocketHandle)handle);
+    handle = -1;
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+bool UdpTransport::isOpen() const
+{
+    return handle >= 0;
+}
+
+bool UdpTransport::sendNow(const void* data, size_t size)
+{
+    if (handle < 0) return false;
+
+    sockaddr_in remote{};
+    remote.sin_family = AF_INET;
+    remote.sin_addr.s_addr = remoteAddress;
+    remote.sin_port = remotePort;
+
+    return sendto((SocketHandle)handle, (const char*)data, (int)size, 0, (const sockaddr*)&remote, sizeof(remote)) == (int)size;
+}
+
+size_t UdpTransport::receiveNow(void* buffer, size_t capacity)
+{
+    if (handle < 0) return 0;
+
+    for (;;)
+    {
+        sockaddr_in from{};
+        SocketLength fromLength = sizeof(from);
+
+        const int size = (int)recvfrom((SocketHandle)handle, (char*)buffer, (int)capacity, 0, (sockaddr*)&from, &fromLength);
+
+        if (size < 0)
+        {
+#ifdef _WIN32
+            // A datagram sent before the peer opened its port comes back as a reset, the socket is still fine
+            if (WSAGetLastError() == WSAECONNRESET) continue;
+#else
+            if (errno == EINTR) continue;
+#endif
+            return 0;
+        }
+
+        // Anything that is not from the peer is ignored
+        if (from.sin_addr.s_addr != remoteAddress || from.sin_port != remotePort) continue;
+
+        return (size_t)size;
+    }
+}
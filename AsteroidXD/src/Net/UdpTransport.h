@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include "Transport.h"
+
+/// <summary>
+/// Transporte UDP sin bloqueo hacia un solo par, pensado para dos instancias del juego
+/// en la misma maquina (127.0.0.1) o en la misma red. Solo acepta datagramas de ese par.
+/// </summary>
+class UdpTransport : public Transport
+{
+private:
+    // SOCKET on Windows, a file descriptor elsewhere; the header stays free of the platform includes
+    intptr_t handle = -1;
+    uint32_t remoteAddress = 0;
+    uint16_t remotePort = 0;
+
+protected:
+    bool sendNow(const void* data, size_t size) override;
+    size_t receiveNow(void* buffer, size_t capacity) override;
+
+public:
+    UdpTransport() = default;
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+    ~UdpTransport();
+
+    /// <summary>
+    /// Abre el puerto local y fija el par
+    /// </summary>
+    /// <param name="localPort"></param>
+    /// <param name="remoteHost">IPv4 numerica, por ejemplo 127.0.0.1</param>
+    /// <param name="remotePort"></param>
+    /// <returns>false si el puerto esta ocupado o la direccion no es valida</returns>
+    bool open(uint16_t localPort, const char remoteHost[], uint16_t remotePort);
+    void close();
+    bool isOpen() const;
+};
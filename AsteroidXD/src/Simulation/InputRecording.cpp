@@ -0,0 +1,110 @@
+#include "InputRecording.h"
+#include <fstream>
+
+static const char recordingMagic[4] = { 'A', 'X', 'D', 'R' };
+static const uint32_t recordingVersion = 1;
+
+// Per tick: aim x, aim y and one byte of buttons
+static const unsigned char thrustFlag = 1 << 0;
+static const unsigned char fireFlag = 1 << 1;
+
+template<typename T>
+static void Write(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool Read(std::ifstream& file, T& value)
+{
+    return (bool)file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+void InputRecording::begin(const SimConfig& config, int level, uint64_t seed, float step)
+{
+    this->level = level;
+    this->seed = seed;
+    this->step = step;
+    width = config.width;
+    height = config.height;
+    stressMeteors = config.stressMeteors;
+    inputs.clear();
+}
+
+void InputRecording::record(const SimInput& input)
+{
+    inputs.push_back(input);
+}
+
+SimConfig InputRecording::getConfig() const
+{
+    SimConfig config;
+    config.width = width;
+    config.height = height;
+    config.stressMeteors = stressMeteors;
+    return config;
+}
+
+bool InputRecording::save(const char fileName[]) const
+{
+    std::ofstream file(fileName, std::ios::binary);
+    if (!file) return false;
+
+    file.write(recordingMagic, sizeof(recordingMagic));
+    Write(file, recordingVersion);
+    Write(file, (int32_t)level);
+    Write(file, seed);
+    Write(file, step);
+    Write(file, width);
+    Write(file, height);
+    Write(file, (int32_t)stressMeteors);
+    Write(file, (uint32_t)inputs.size());
+
+    for (const SimInput& input : inputs)
+    {
+        unsigned char buttons = (input.thrust ? thrustFlag : 0) | (input.fire ? fireFlag : 0);
+
+        Write(file, input.aim.x);
+        Write(file, input.aim.y);
+        Write(file, buttons);
+    }
+
+    return (bool)file;
+}
+
+bool InputRecording::load(const char fileName[])
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file) return false;
+
+    char magic[4];
+    uint32_t version = 0;
+    int32_t fileLevel = 0;
+    int32_t fileStress = 0;
+    uint32_t count = 0;
+
+    if (!file.read(magic, sizeof(magic)) || std::char_traits<char>::compare(magic, recordingMagic, sizeof(magic)) != 0) return false;
+    if (!Read(file, version) || version != recordingVersion) return false;
+
+    if (!Read(file, fileLevel) || !Read(file, seed) || !Read(file, step) || !Read(file, width) ||
+        !Read(file, height) || !Read(file, fileStress) || !Read(file, count)) return false;
+
+    level = fileLevel;
+    stressMeteors = fileStress;
+    inputs.clear();
+    inputs.reserve(count);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        SimInput input;
+        unsigned char buttons = 0;
+
+        if (!Read(file, input.aim.x) || !Read(file, input.aim.y) || !Read(file, buttons)) return false;
+
+        input.thrust = (buttons & thrustFlag) != 0;
+        input.fire = (buttons & fireFlag) != 0;
+        inputs.push_back(input);
+    }
+
+    return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Simulation/SimTypes.h"
+
+/// <summary>
+/// Todo lo necesario para volver a jugar una partida: la configuracion, el nivel,
+/// la semilla y el SimInput de cada tick. Con eso la Simulation se reproduce igual.
+/// </summary>
+struct InputRecording
+{
+    int level = 1;
+    uint64_t seed = 0;
+    float step = 1.0f / 120.0f;
+    float width = 1024.0f;
+    float height = 720.0f;
+    int stressMeteors = 0;
+    std::vector<SimInput> inputs;
+
+    /// <summary>
+    /// Empieza una grabacion nueva para una partida que arranca con este estado
+    /// </summary>
+    void begin(const SimConfig& config, int level, uint64_t seed, float step);
+
+    void record(const SimInput& input);
+
+    /// <summary>
+    /// Configuracion para reconstruir la Simulation grabada
+    /// </summary>
+    /// <returns></returns>
+    SimConfig getConfig() const;
+
+    /// <summary>
+    /// Guarda la grabacion en formato binario
+    /// </summary>
+    /// <returns>false si no se pudo escribir el archivo</returns>
+    bool save(const char fileName[]) const;
+
+    /// <summary>
+    /// Carga una grabacion guardada con save()
+    /// </summary>
+    /// <returns>false si el archivo no existe o no es una grabacion valida</returns>
+    bool load(const char fileName[]);
+};
@@ -0,0 +1,127 @@
+#include "MeteorField.h"
+#include "Utils/Vector2Batch.h"
+
+void MeteorField::reset(int capacity)
+{
+    positionX.assign(capacity, 0.0f);
+    positionY.assign(capacity, 0.0f);
+    previousX.assign(capacity, 0.0f);
+    previousY.assign(capacity, 0.0f);
+    speedX.assign(capacity, 0.0f);
+    speedY.assign(capacity, 0.0f);
+    radius.assign(capacity, 0.0f);
+    rotation.assign(capacity, 0.0f);
+    tier.assign(capacity, 0);
+    active.assign(capacity, 0);
+
+    slots.reset(capacity);
+}
+
+void MeteorField::grow(int capacity)
+{
+    if (capacity <= size()) return;
+
+    positionX.resize(capacity, 0.0f);
+    positionY.resize(capacity, 0.0f);
+    previousX.resize(capacity, 0.0f);
+    previousY.resize(capacity, 0.0f);
+    speedX.resize(capacity, 0.0f);
+    speedY.resize(capacity, 0.0f);
+    radius.resize(capacity, 0.0f);
+    rotation.resize(capacity, 0.0f);
+    tier.resize(capacity, 0);
+    active.resize(capacity, 0);
+
+    slots.grow(capacity);
+}
+
+void MeteorField::resize(int capacity)
+{
+    positionX.resize(capacity, 0.0f);
+    positionY.resize(capacity, 0.0f);
+    previousX.resize(capacity, 0.0f);
+    previousY.resize(capacity, 0.0f);
+    speedX.resize(capacity, 0.0f);
+    speedY.resize(capacity, 0.0f);
+    radius.resize(capacity, 0.0f);
+    rotation.resize(capacity, 0.0f);
+    tier.resize(capacity, 0);
+    active.resize(capacity, 0);
+}
+
+int MeteorField::spawn(Vector2 position, Vector2 speed, float radius, float rotation, int tier)
+{
+    int index = slots.acquire();
+
+    if (index < 0)
+    {
+        grow(size() > 0 ? size() * 2 : 16);
+        index = slots.acquire();
+    }
+
+    positionX[index] = position.x;
+    positionY[index] = position.y;
+    previousX[index] = position.x;
+    previousY[index] = position.y;
+    speedX[index] = speed.x;
+    speedY[index] = speed.y;
+    this->radius[index] = radius;
+    this->rotation[index] = rotation;
+    this->tier[index] = (unsigned char)tier;
+    active[index] = 1;
+
+    return index;
+}
+
+void MeteorField::despawn(int index)
+{
+    active[index] = 0;
+    slots.release(index);
+}
+
+int MeteorField::size() const
+{
+    return (int)positionX.size();
+}
+
+int MeteorField::getActiveCount() const
+{
+    return slots.getCount();
+}
+
+Vector2 MeteorField::getPosition(int index) const
+{
+    return Vector2{ positionX[index], positionY[index] };
+}
+
+Vector2 MeteorField::getPreviousPosition(int index) const
+{
+    return Vector2{ previousX[index], previousY[index] };
+}
+
+void MeteorField::storePreviousPositions()
+{
+    previousX = positionX;
+    previousY = positionY;
+}
+
+void MeteorField::move(float dt)
+{
+    move(dt, 0, size());
+}
+
+void MeteorField::move(float dt, int begin, int end)
+{
+    // Inactive meteors get a zero step instead of a branch
+    Vector2AddScaledMasked(positionX.data() + begin, positionY.data() + begin, speedX.data() + begin, speedY.data() + begin, active.data() + begin, dt, end - begin);
+}
+
+void MeteorField::wrap(float width, float height)
+{
+    wrap(width, height, 0, size());
+}
+
+void MeteorField::wrap(float width, float height, int begin, int end)
+{
+    Vector2WrapMasked(positionX.data() + begin, positionY.data() + begin, radius.data() + begin, active.data() + begin, width, height, end - begin);
+}
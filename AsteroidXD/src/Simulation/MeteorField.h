@@ -0,0 +1,88 @@
+#pragma once
+#include <vector>
+#include "Utils/Vector2Utils.h"
+#include "Utils/Pool.h"
+
+/// <summary>
+/// Todos los meteoros de la partida en arrays contiguos (structure of arrays).
+/// El movimiento y el wraparound recorren cada array de punta a punta,
+/// sin punteros ni vtables, para que el compilador pueda vectorizar.
+/// Los slots se reciclan con una free-list: romper un meteoro no reserva memoria.
+/// </summary>
+struct MeteorField
+{
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> previousX;
+    std::vector<float> previousY;
+    std::vector<float> speedX;
+    std::vector<float> speedY;
+    std::vector<float> radius;
+    std::vector<float> rotation;
+    std::vector<unsigned char> tier;        // 0 is a big meteor, each split adds one
+    std::vector<unsigned char> active;
+
+    SlotAllocator slots;
+
+    /// <summary>
+    /// Deja capacity slots, todos inactivos
+    /// </summary>
+    /// <param name="capacity"></param>
+    void reset(int capacity);
+
+    /// <summary>
+    /// Agrega slots inactivos, los indices existentes siguen siendo validos
+    /// </summary>
+    /// <param name="capacity"></param>
+    void grow(int capacity);
+
+    /// <summary>
+    /// Cambia la cantidad de slots sin tocar la free-list, para restaurar snapshots.
+    /// Achicar no libera memoria, asi volver a crecer hasta el tamaño anterior tampoco reserva
+    /// </summary>
+    /// <param name="capacity"></param>
+    void resize(int capacity);
+
+    /// <summary>
+    /// Activa un meteoro en un slot libre. Si no queda ninguno el campo duplica su capacidad:
+    /// solo reserva memoria cuando se supera el maximo de meteoros vivos hasta ahora.
+    /// </summary>
+    /// <returns>Indice del meteoro</returns>
+    int spawn(Vector2 position, Vector2 speed, float radius, float rotation, int tier);
+
+    /// <summary>
+    /// Desactiva el meteoro y libera su slot
+    /// </summary>
+    /// <param name="index"></param>
+    void despawn(int index);
+
+    /// <summary>
+    /// Cantidad de slots, activos o no: el limite para recorrer los arrays
+    /// </summary>
+    /// <returns></returns>
+    int size() const;
+    int getActiveCount() const;
+    Vector2 getPosition(int index) const;
+    Vector2 getPreviousPosition(int index) const;
+
+    void storePreviousPositions();
+
+    /// <summary>
+    /// Mueve los meteoros activos segun su velocidad
+    /// </summary>
+    /// <param name="dt"></param>
+    void move(float dt);
+
+    /// <summary>
+    /// Igual que move pero solo para los slots [begin, end), para repartir el campo entre hilos
+    /// </summary>
+    void move(float dt, int begin, int end);
+
+    /// <summary>
+    /// Los meteoros activos que salen de la pantalla reaparecen del lado opuesto
+    /// </summary>
+    /// <param name="width"></param>
+    /// <param name="height"></param>
+    void wrap(float width, float height);
+    void wrap(float width, float height, int begin, int end);
+};
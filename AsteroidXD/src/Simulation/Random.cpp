@@ -0,0 +1,63 @@
+#include "Random.h"
+
+Random::Random(uint64_t seed, uint64_t stream)
+{
+    this->seed(seed, stream);
+}
+
+void Random::seed(uint64_t seed, uint64_t stream)
+{
+    state = 0;
+    increment = (stream << 1u) | 1u;
+    next();
+    state += seed;
+    next();
+}
+
+uint32_t Random::next()
+{
+    uint64_t old = state;
+    state = old * 6364136223846793005ULL + increment;
+
+    uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+    uint32_t rot = (uint32_t)(old >> 59u);
+
+    return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+}
+
+int Random::range(int min, int max)
+{
+    if (min > max)
+    {
+        int tmp = max;
+        max = min;
+        min = tmp;
+    }
+
+    // Rejection keeps the distribution uniform, modulo alone favours the low values
+    const uint32_t bound = (uint32_t)((int64_t)max - (int64_t)min + 1);
+    const uint32_t threshold = (0u - bound) % bound;
+
+    for (;;)
+    {
+        uint32_t r = next();
+        if (r >= threshold) return min + (int)(r % bound);
+    }
+}
+
+uint64_t Random::getState() const
+{
+    return state;
+}
+
+uint64_t Random::getIncrement() const
+{
+    return increment;
+}
+
+void Random::restore(uint64_t state, uint64_t increment)
+{
+    this->state = state;
+    // PCG needs an odd increment
+    this->increment = increment | 1u;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// Generador pseudoaleatorio PCG32 con semilla y stream propios.
+/// Dos Random con la misma semilla y stream dan siempre la misma secuencia,
+/// en cualquier maquina, asi una partida se puede reproducir bit a bit.
+/// </summary>
+class Random
+{
+private:
+    uint64_t state = 0;
+    uint64_t increment = 1;
+
+public:
+    Random(uint64_t seed = 0, uint64_t stream = 0);
+
+    /// <summary>
+    /// Reinicia la secuencia, streams distintos con la misma semilla no se solapan
+    /// </summary>
+    /// <param name="seed"></param>
+    /// <param name="stream"></param>
+    void seed(uint64_t seed, uint64_t stream);
+
+    uint32_t next();
+
+    /// <summary>
+    /// Entero entre min y max (ambos incluidos), mismo contrato que GetRandomValue de raylib
+    /// </summary>
+    /// <param name="min"></param>
+    /// <param name="max"></param>
+    /// <returns></returns>
+    int range(int min, int max);
+
+    // Raw generator state, for snapshots
+    uint64_t getState() const;
+    uint64_t getIncrement() const;
+    void restore(uint64_t state, uint64_t increment);
+};
@@ -0,0 +1,125 @@
+#include "RaySensor.h"
+#include <algorithm>
+#include <cmath>
+
+RaySensor::RaySensor(int rays, float range, const SimConfig& config)
+{
+    this->rays = std::max(rays, 1);
+
+    // Farther than this a meteor could touch a ray with the copy on the other side of the screen
+    const float maxRange = std::min(config.width, config.height) * 0.5f - config.bigMeteorRadius;
+    this->range = std::max(std::min(range, maxRange), 1.0f);
+
+    // x along the nose and y to its right, clockwise like the rotation of the ship
+    for (int k = 0; k < this->rays; k++)
+    {
+        const float angle = 2.0f * PI * k / this->rays;
+        baseX.push_back(cosf(angle));
+        baseY.push_back(sinf(angle));
+    }
+
+    dirX.resize(this->rays);
+    dirY.resize(this->rays);
+}
+
+void RaySensor::cast(const Simulation& simulation, int player, float meteorHits[], float powerUpHits[])
+{
+    const SimConfig& config = simulation.getConfig();
+    const ShipState& ship = simulation.getShip(player);
+
+    // The nose points up at rotation 0 and y grows down
+    const float noseX = sinf(ship.rotation * DEG2RAD);
+    const float noseY = -cosf(ship.rotation * DEG2RAD);
+
+    for (int k = 0; k < rays; k++)
+    {
+        dirX[k] = noseX * baseX[k] - noseY * baseY[k];
+        dirY[k] = noseY * baseX[k] + noseX * baseY[k];
+
+        meteorHits[k] = range;
+        powerUpHits[k] = range;
+    }
+
+    // Broad phase once for every ray, the grid only hands over the cells around the ship
+    const MeteorField& meteors = simulation.getMeteors();
+
+    candidateX.clear();
+    candidateY.clear();
+    candidateRadius.clear();
+
+    simulation.getBroadphase().query(ship.position, range, [&](int i)
+    {
+        if (!meteors.active[i]) return;
+
+        const float x = WrappedDelta(meteors.positionX[i] - ship.position.x, config.width);
+        const float y = WrappedDelta(meteors.positionY[i] - ship.position.y, config.height);
+        const float reach = range + meteors.radius[i];
+
+        if (x * x + y * y > reach * reach) return;
+
+        candidateX.push_back(x);
+        candidateY.push_back(y);
+        candidateRadius.push_back(meteors.radius[i]);
+    });
+
+    for (size_t c = 0; c < candidateX.size(); c++)
+    {
+        castCircle(candidateX[c], candidateY[c], candidateRadius[c], meteorHits);
+    }
+
+    const PowerUpState& powerUp = simulation.getPowerUp();
+
+    if (powerUp.active)
+    {
+        castCircle(WrappedDelta(powerUp.position.x - ship.position.x, config.width),
+            WrappedDelta(powerUp.position.y - ship.position.y, config.height), powerUp.radius, powerUpHits);
+    }
+
+    const float scale = 1.0f / range;
+
+    for (int k = 0; k < rays; k++)
+    {
+        meteorHits[k] *= scale;
+        powerUpHits[k] *= scale;
+    }
+}
+
+void RaySensor::castCircle(float x, float y, float radius, float hits[]) const
+{
+    const float centerSquared = x * x + y * y;
+    const float radiusSquared = radius * radius;
+
+    // The ship is inside the circle, every ray starts on it
+    if (centerSquared <= radiusSquared)
+    {
+        std::fill(hits, hits + rays, 0.0f);
+        return;
+    }
+
+    // One circle against all the rays, contiguous arrays and no branches so the loop vectorizes
+    const float* directionX = dirX.data();
+    const float* directionY = dirY.data();
+
+    for (int k = 0; k < rays; k++)
+    {
+        const float along = x * directionX[k] + y * directionY[k];
+        const float inside = radiusSquared - (centerSquared - along * along);
+        const float entry = along - sqrtf(std::max(inside, 0.0f));
+
+        hits[k] = (inside >= 0.0f && along > 0.0f && entry < hits[k]) ? entry : hits[k];
+    }
+}
+
+#pragma region GETTERS
+
+int RaySensor::getRayCount() const
+{
+    return rays;
+}
+
+float RaySensor::getRange() const
+{
+    return range;
+}
+
+#pragma endregion
@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include "Simulation/Simulation.h"
+
+/// <summary>
+/// Rayos que salen de una nave repartidos en 360 grados, el primero hacia donde apunta la nariz.
+/// Cada rayo informa la distancia al meteoro y al power-up mas cercanos que toca, dando la vuelta
+/// por los bordes de la pantalla igual que las entidades.
+/// Todos los rayos comparten el mismo origen: los meteoros a su alcance se juntan una sola vez
+/// con la grilla de la simulacion y despues cada uno se prueba contra todos los rayos a la vez.
+/// </summary>
+class RaySensor
+{
+private:
+    int rays;
+    float range;
+
+    // Ray directions relative to the nose, rotated into screen space on each cast
+    std::vector<float> baseX;
+    std::vector<float> baseY;
+    std::vector<float> dirX;
+    std::vector<float> dirY;
+
+    // Meteors in range, as offsets from the ship on the nearest copy of the screen
+    std::vector<float> candidateX;
+    std::vector<float> candidateY;
+    std::vector<float> candidateRadius;
+
+private:
+    void castCircle(float x, float y, float radius, float hits[]) const;
+
+public:
+    /// <summary>
+    /// El alcance se limita a media pantalla menos el radio del meteoro mas grande,
+    /// asi cada meteoro solo se puede tocar en una de sus copias
+    /// </summary>
+    /// <param name="rays"></param>
+    /// <param name="range">Distancia maxima en pixeles</param>
+    /// <param name="config">Configuracion de las simulaciones que va a leer</param>
+    RaySensor(int rays, float range, const SimConfig& config);
+
+    /// <summary>
+    /// Tira todos los rayos desde la nave del jugador.
+    /// Las distancias van divididas por el alcance: 1 si el rayo no toca nada, 0 si la nave ya esta encima.
+    /// </summary>
+    /// <param name="simulation"></param>
+    /// <param name="player"></param>
+    /// <param name="meteorHits">getRayCount() floats</param>
+    /// <param name="powerUpHits">getRayCount() floats</param>
+    void cast(const Simulation& simulation, int player, float meteorHits[], float powerUpHits[]);
+
+    int getRayCount() const;
+    float getRange() const;
+};
@@ -0,0 +1,139 @@
+#pragma once
+#include "Utils/Vector2Utils.h"
+
+#pragma region SIMULATION CONFIG
+
+/// <summary>
+/// Parametros de la simulacion, no dependen de la ventana ni del audio
+/// </summary>
+struct SimConfig
+{
+    float width = 1024.0f;
+    float height = 720.0f;
+
+    // Velocities are in pixels per second and timers in seconds, so
+    // the game plays the same whatever the tick rate is
+    int shipMaxShoots = 10;
+    int shipMaxShield = 100;
+    float shipRadius = 18.0f;
+    float shipMaxVelocity = 180.0f;
+    float shipMaxAcceleration = 150.0f;
+    float shipThrust = 150.0f;
+    float shipHitImpulse = 60.0f;
+
+    // Each meteor touching the ship takes a point of shield and pushes it once per interval,
+    // what the original game did once per frame at 60 fps
+    float shipHitInterval = 1.0f / 60.0f;
+
+    float shootRadius = 2.0f;
+    float shootSpeed = 225.0f;
+    float shootMaxLifeSpawn = 8.33f;
+
+    float meteorsSpeed = 150.0f;
+    int baseAmountBigMeteors = 4;
+    float bigMeteorRadius = 40.0f;
+
+    // A hit meteor breaks into meteorSplitFactor fragments of the next tier, each
+    // meteorRadiusScale times the radius of its parent. Meteors of the last tier just explode.
+    // The simulation clamps the tiers and the split factor to [1, 255] and the scale to 0.01 or more
+    int meteorSplitFactor = 2;
+    int meteorTiers = 3;
+    float meteorRadiusScale = 0.5f;
+
+    // Stress mode: when greater than zero it replaces the big meteors of the level
+    int stressMeteors = 0;
+
+    float powerUpRespawnTime = 5.0f;
+
+    // Ships sharing the meteor field, 2 in co-op. Each one has its own shipMaxShoots
+    int players = 1;
+};
+
+#pragma endregion
+
+#pragma region SIMULATION INPUT
+
+/// <summary>
+/// Entrada de un tick de simulacion, es lo que antes se leia del mouse
+/// </summary>
+struct SimInput
+{
+    Vector2 aim{ 0,0 };
+    bool thrust = false;
+    bool fire = false;
+};
+
+#pragma endregion
+
+#pragma region SIMULATION STATE
+
+struct ShipState
+{
+    Vector2 position{ 0,0 };
+    Vector2 previousPosition{ 0,0 };
+    Vector2 velocity{ 0,0 };
+    Vector2 dir{ 0,0 };
+    float acceleration = 0.0f;
+    float rotation = 0.0f;
+    float radius = 0.0f;
+    int shield = 0;
+
+    // Seconds until meteors can hit the ship again
+    float hitCooldown = 0.0f;
+
+    // Shots of this ship still flying, at most shipMaxShoots
+    int activeShoots = 0;
+};
+
+struct ShootState
+{
+    Vector2 position{ 0,0 };
+    Vector2 previousPosition{ 0,0 };
+    Vector2 speed{ 0,0 };
+    float radius = 0.0f;
+    float rotation = 0.0f;
+    float lifeSpawn = 0.0f;
+    bool active = false;
+
+    // Player whose ship fired it
+    int owner = 0;
+};
+
+struct PowerUpState
+{
+    Vector2 position{ 0,0 };
+    Vector2 previousPosition{ 0,0 };
+    Vector2 speed{ 0,0 };
+    float rotation = 0.0f;
+    float radius = 0.0f;
+    float timer = 0.0f;
+    bool active = false;
+};
+
+#pragma endregion
+
+#pragma region SIMULATION EVENTS
+
+enum class SimEventType
+{
+    ShootFired,
+    MeteorDestroyed,
+    ShipDamaged,
+    ShipDestroyed,
+    PowerUpCollected
+};
+
+/// <summary>
+/// Algo que paso durante un tick, la capa de presentacion lo usa para sonidos y efectos
+/// </summary>
+struct SimEvent
+{
+    SimEventType type;
+    Vector2 position;
+    float pitch;
+
+    // Ship that fired, was hit or collected; for a destroyed meteor the one that shot it
+    int player;
+};
+
+#pragma endregion
@@ -0,0 +1,916 @@
+#include "Simulation.h"
+#include <algorithm>
+#include "Utils/ByteStream.h"
+#include "Utils/Profiler.h"
+#include "Utils/JobSystem.h"
+
+#pragma region HELPERS
+
+static bool CirclesOverlap(Vector2 center1, float radius1, Vector2 center2, float radius2)
+{
+    float dx = center2.x - center1.x;
+    float dy = center2.y - center1.y;
+    float radii = radius1 + radius2;
+
+    return (dx * dx + dy * dy) <= radii * radii;
+}
+
+static void WrapPosition(Vector2& position, float radius, float width, float height)
+{
+    if (position.x > width + radius) position.x = -radius;
+    else if (position.x < -radius) position.x = width + radius;
+
+    if (position.y > height + radius) position.y = -radius;
+    else if (position.y < -radius) position.y = height + radius;
+}
+
+// Meteors moved by each job of the update
+static const int meteorChunkSize = 16384;
+
+// A hit due less than this fraction of a tick before the next one waits for it, so float
+// error in the cooldown can not add or drop a hit when the interval is a multiple of the tick
+static const float hitTickTolerance = 0.001f;
+
+// MeteorField keeps the tier of each meteor in a byte, the fragments of a split get the same bound
+static const int maxMeteorTiers = 255;
+static const int maxMeteorSplitFactor = 255;
+
+// Fragments always have some size, a scale of 0 or less would make them invisible and untouchable
+static const float minMeteorRadiusScale = 0.01f;
+
+// Below this many active meteors the shot queries are too cheap to hand out to other threads
+static const int parallelQueryMeteors = 20000;
+
+// Most meteors that can be alive at once, when every big one is split down to the last
+// tier, plus the fragments of one split that exist while their parent is still alive
+static int MeteorCapacity(int bigMeteors, const SimConfig& config)
+{
+    // Beyond this the field grows on demand instead of reserving the worst case up front
+    const long long maxReserved = 1 << 20;
+
+    long long meteors = bigMeteors;
+    for (int tier = 1; tier < config.meteorTiers && meteors < maxReserved; tier++) meteors *= config.meteorSplitFactor;
+
+    return (int)std::min(meteors, maxReserved) + config.meteorSplitFactor;
+}
+
+#pragma endregion
+
+const int Simulation::maxPlayers;
+
+Simulation::Simulation(const SimConfig& config) : config(config) { }
+
+void Simulation::setConfig(const SimConfig& config)
+{
+    this->config = config;
+}
+
+void Simulation::reset(int level, uint64_t seed)
+{
+    config.players = std::min(std::max(config.players, 1), maxPlayers);
+
+    this->level = level;
+    this->seed = seed;
+    gameplayRandom.seed(seed, gameplayStream);
+    cosmeticRandom.seed(seed, cosmeticStream);
+    gameOver = false;
+    victory = false;
+    tick = 0;
+    events.clear();
+
+    ships.assign(config.players, ShipState{});
+
+    for (int player = 0; player < config.players; player++)
+    {
+        // Side by side around the center, a single ship starts right at it
+        const float offset = (player - (config.players - 1) * 0.5f) * config.shipRadius * 4;
+
+        ShipState& ship = ships[player];
+        ship.position = Vector2{ config.width / 2 - config.shipRadius / 2 + offset, config.height / 2 - config.shipRadius / 2 };
+        ship.radius = config.shipRadius;
+        ship.shield = config.shipMaxShield;
+    }
+
+    hpPowerUp = PowerUpState{};
+    hpPowerUp.radius = config.shipRadius;
+    hpPowerUp.timer = config.powerUpRespawnTime;
+
+    ShootState shoot;
+    shoot.radius = config.shootRadius;
+    shoots.reset(config.shipMaxShoots * config.players, shoot);
+
+    int maxBigMeteors = (config.stressMeteors > 0) ? config.stressMeteors : config.baseAmountBigMeteors * level;
+
+    applyConfig();
+
+    // Slots freed by destroyed meteors are reused by the fragments, so splitting does not allocate
+    meteors.reset(MeteorCapacity(maxBigMeteors, config));
+
+    spawnBigMeteors(maxBigMeteors);
+
+    broadphase.build(meteors);
+}
+
+void Simulation::applyConfig()
+{
+    config.meteorTiers = std::min(std::max(config.meteorTiers, 1), maxMeteorTiers);
+    config.meteorSplitFactor = std::min(std::max(config.meteorSplitFactor, 1), maxMeteorSplitFactor);
+    config.meteorRadiusScale = fmaxf(config.meteorRadiusScale, minMeteorRadiusScale);
+
+    tierRadius.assign(config.meteorTiers, config.bigMeteorRadius);
+    for (size_t tier = 1; tier < tierRadius.size(); tier++) tierRadius[tier] = tierRadius[tier - 1] * config.meteorRadiusScale;
+
+    broadphase.configure(config.width, config.height, config.bigMeteorRadius * 2);
+}
+
+void Simulation::spawnBigMeteors(int count)
+{
+    const int width = (int)config.width;
+    const int height = (int)config.height;
+    const int speed = (int)config.meteorsSpeed;
+
+    for (int i = 0; i < count; i++)
+    {
+        // Keep the spawn away from the ship, that starts at the center of the screen
+        float posx = (float)gameplayRandom.range(0, width);
+        while (posx > width / 2 - 150 && posx < width / 2 + 150) posx = (float)gameplayRandom.range(0, width);
+
+        float posy = (float)gameplayRandom.range(0, height);
+        while (posy > height / 2 - 150 && posy < height / 2 + 150) posy = (float)gameplayRandom.range(0, height);
+
+        float velx = (float)gameplayRandom.range(-speed, speed);
+        float vely = (float)gameplayRandom.range(-speed, speed);
+
+        while (velx == 0 && vely == 0)
+        {
+            velx = (float)gameplayRandom.range(-speed, speed);
+            vely = (float)gameplayRandom.range(-speed, speed);
+        }
+
+        meteors.spawn(Vector2{ posx, posy }, Vector2{ velx, vely }, tierRadius[0], (float)gameplayRandom.range(0, 360), 0);
+    }
+}
+
+void Simulation::pushEvent(SimEventType type, Vector2 position, int player)
+{
+    // Pitch variation is cosmetic, it never feeds back into the gameplay stream
+    float pitch = ((float)cosmeticRandom.range(0, 45) / 100) + 1;
+    events.push_back(SimEvent{ type, position, pitch, player });
+}
+
+void Simulation::step(const SimInput& input, float dt)
+{
+    step(&input, 1, dt);
+}
+
+void Simulation::step(const SimInput inputs[], int count, float dt)
+{
+    events.clear();
+
+    if (gameOver) return;
+
+    tick++;
+
+    storePreviousPositions();
+
+    {
+        PROFILE_SCOPE("Sim/Ship");
+
+        for (int player = 0; player < (int)ships.size(); player++)
+        {
+            ShipState& ship = ships[player];
+
+            // A destroyed ship waits for the end of the match
+            if (ship.shield <= 0) continue;
+
+            // Aiming at itself keeps the rotation of a player without input
+            SimInput idle;
+            idle.aim = ship.position;
+
+            updateShip(ship, (player < count) ? inputs[player] : idle, dt);
+        }
+
+        updatePowerUp(dt);
+
+        for (int player = 0; player < count && player < (int)ships.size(); player++)
+        {
+            if (inputs[player].fire && ships[player].shield > 0) fireShoot(player);
+        }
+
+        updateShoots(dt);
+    }
+
+    {
+        PROFILE_SCOPE("Sim/Meteors");
+
+        // Every slot only depends on itself, the chunks can run on any thread
+        JobSystem::instance().parallelFor(meteors.size(), meteorChunkSize, [&](int begin, int end)
+        {
+            meteors.move(dt, begin, end);
+            meteors.wrap(config.width, config.height, begin, end);
+        });
+    }
+
+    {
+        PROFILE_SCOPE("Sim/Broadphase");
+        broadphase.build(meteors);
+    }
+
+    {
+        PROFILE_SCOPE("Sim/Collisions");
+        checkShipCollisions(dt);
+
+        // Broken meteors leave the grid behind the field, sensors read it between steps
+        if (checkShootCollisions()) broadphase.build(meteors);
+    }
+
+    if (meteors.getActiveCount() == 0) victory = true;
+}
+
+void Simulation::storePreviousPositions()
+{
+    for (ShipState& ship : ships) ship.previousPosition = ship.position;
+    hpPowerUp.previousPosition = hpPowerUp.position;
+
+    for (ShootState& s : shoots) s.previousPosition = s.position;
+    meteors.storePreviousPositions();
+}
+
+void Simulation::updateShip(ShipState& ship, const SimInput& input, float dt)
+{
+    // Player logic: rotation
+    if (Vector2Length(Vector2Subtract(input.aim, ship.position)) > 40.0f)
+    {
+        ship.rotation = Vector2Angle(ship.position, input.aim) + 90;
+        ship.dir = Vector2Normalize(Vector2Subtract(input.aim, ship.position));
+    }
+
+    // Player logic: acceleration
+    if (input.thrust)
+    {
+        Vector2 speed{ ship.dir.x, -ship.dir.y };
+
+        ship.velocity = Vector2Add(ship.velocity, Vector2Scale(speed, ship.acceleration * config.shipThrust * dt));
+
+        ship.acceleration = fminf(ship.acceleration + config.shipMaxAcceleration * dt, 1.0f);
+    }
+    else
+    {
+        ship.acceleration = fmaxf(ship.acceleration - dt, 0.0f);
+    }
+
+    ship.velocity = { Clamp(ship.velocity.x, -config.shipMaxVelocity, config.shipMaxVelocity), Clamp(ship.velocity.y, -config.shipMaxVelocity, config.shipMaxVelocity) };
+
+    // Player logic: movement
+    ship.position.x += ship.velocity.x * dt;
+    ship.position.y -= ship.velocity.y * dt;
+
+    WrapPosition(ship.position, ship.radius, config.width, config.height);
+}
+
+void Simulation::updatePowerUp(float dt)
+{
+    if (hpPowerUp.active)
+    {
+        WrapPosition(hpPowerUp.position, hpPowerUp.radius, config.width, config.height);
+
+        hpPowerUp.position.x += hpPowerUp.speed.x * dt;
+        hpPowerUp.position.y += hpPowerUp.speed.y * dt;
+    }
+    else
+    {
+        if (hpPowerUp.timer > 0)
+        {
+            hpPowerUp.timer -= dt;
+        }
+        else
+        {
+            float angle = (float)gameplayRandom.range(0, 360);
+            hpPowerUp.speed = Vector2{ (float)cos(angle * DEG2RAD) * config.meteorsSpeed, (float)sin(angle * DEG2RAD) * config.meteorsSpeed };
+            hpPowerUp.active = true;
+        }
+    }
+
+    // With both ships on it the first player gets it
+    for (int player = 0; player < (int)ships.size() && hpPowerUp.active; player++)
+    {
+        ShipState& ship = ships[player];
+        if (ship.shield <= 0 || !CirclesOverlap(ship.position, ship.radius, hpPowerUp.position, hpPowerUp.radius)) continue;
+
+        hpPowerUp.active = false;
+        hpPowerUp.timer = config.powerUpRespawnTime;
+        ship.shield = config.shipMaxShield;
+        pushEvent(SimEventType::PowerUpCollected, hpPowerUp.position, player);
+    }
+}
+
+void Simulation::fireShoot(int player)
+{
+    // The pool is shared, but no player can take more than shipMaxShoots of it
+    ShipState& ship = ships[player];
+    if (ship.activeShoots >= config.shipMaxShoots) return;
+
+    const int index = shoots.acquire();
+    if (index < 0) return;
+
+    ship.activeShoots++;
+    ShootState& s = shoots[index];
+
+    s.position = Vector2
+    {
+        ship.position.x + (float)sin(ship.rotation * DEG2RAD) * ship.radius,
+        ship.position.y - (float)cos(ship.rotation * DEG2RAD) * ship.radius
+    };
+
+    s.previousPosition = s.position;
+    s.active = true;
+    s.lifeSpawn = 0;
+    s.rotation = ship.rotation;
+    s.speed = Vector2{ sinf(ship.rotation * DEG2RAD) * config.shootSpeed, cosf(ship.rotation * DEG2RAD) * config.shootSpeed };
+    s.owner = player;
+
+    pushEvent(SimEventType::ShootFired, s.position, player);
+}
+
+void Simulation::releaseShoot(int index)
+{
+    // The views only see the state, so the flag follows the pool
+    shoots[index].active = false;
+    shoots[index].lifeSpawn = 0;
+    shoots.release(index);
+
+    ships[shoots[index].owner].activeShoots--;
+}
+
+void Simulation::updateShoots(float dt)
+{
+    for (int i = 0; i < shoots.getCapacity(); i++)
+    {
+        if (!shoots.isActive(i)) continue;
+
+        ShootState& s = shoots[i];
+
+        s.lifeSpawn += dt;
+        s.position.x += s.speed.x * dt;
+        s.position.y -= s.speed.y * dt;
+
+        // Collision logic: shoot vs walls
+        if (s.position.x > config.width + s.radius || s.position.x < -s.radius ||
+            s.position.y > config.height + s.radius || s.position.y < -s.radius)
+        {
+            releaseShoot(i);
+        }
+        // Life of shoot
+        else if (s.lifeSpawn >= config.shootMaxLifeSpawn)
+        {
+            s.position = Vector2{ 0, 0 };
+            s.speed = Vector2{ 0, 0 };
+            releaseShoot(i);
+        }
+    }
+}
+
+void Simulation::damageShip(int player, Vector2 hitPos)
+{
+    ShipState& ship = ships[player];
+    Vector2 pushDir = Vector2Normalize(Vector2Subtract(ship.position, hitPos));
+
+    ship.acceleration = 0;
+    ship.velocity.x += pushDir.x * config.shipHitImpulse;
+    ship.velocity.y -= pushDir.y * config.shipHitImpulse;
+    ship.shield--;
+
+    pushEvent(SimEventType::ShipDamaged, hitPos, player);
+
+    if (ship.shield <= 0)
+    {
+        pushEvent(SimEventType::ShipDestroyed, ship.position, player);
+
+        // The match goes on while any ship is left
+        gameOver = std::none_of(ships.begin(), ships.end(), [](const ShipState& s) { return s.shield > 0; });
+    }
+}
+
+void Simulation::checkShipCollisions(float dt)
+{
+    for (int player = 0; player < (int)ships.size(); player++)
+    {
+        ShipState& ship = ships[player];
+        if (ship.shield <= 0) continue;
+
+        contacts.clear();
+
+        broadphase.query(ship.position, ship.radius, [&](int i)
+        {
+            if (CirclesOverlap(ship.position, ship.radius, meteors.getPosition(i), meteors.radius[i])) contacts.push_back(i);
+        });
+
+        if (contacts.empty())
+        {
+            ship.hitCooldown = fmaxf(ship.hitCooldown - dt, 0.0f);
+            continue;
+        }
+
+        // Cells come out in grid order, the hits are applied in field order
+        std::sort(contacts.begin(), contacts.end());
+
+        // Every hit due during this tick lands now: one every other tick at 120 Hz, two per tick at 30 Hz
+        while (ship.shield > 0 && ship.hitCooldown < dt * (1.0f - hitTickTolerance))
+        {
+            for (int i : contacts)
+            {
+                damageShip(player, meteors.getPosition(i));
+            }
+
+            ship.hitCooldown += config.shipHitInterval;
+        }
+
+        ship.hitCooldown -= dt;
+    }
+}
+
+void Simulation::splitMeteor(int parent, float angle)
+{
+    const int childTier = meteors.tier[parent] + 1;
+    const Vector2 position = meteors.getPosition(parent);
+    const int fragments = config.meteorSplitFactor;
+
+    // The fragments spread evenly around the shot direction, with two of them
+    // one goes back along the shot and the other one follows it
+    for (int j = 0; j < fragments; j++)
+    {
+        const float fragmentAngle = angle + 180.0f + 360.0f * j / fragments;
+        const Vector2 speed{ (float)cos(fragmentAngle * DEG2RAD) * config.meteorsSpeed, (float)sin(fragmentAngle * DEG2RAD) * config.meteorsSpeed };
+
+        spawnedFragments.push_back(meteors.spawn(position, speed, tierRadius[childTier], (float)gameplayRandom.range(0, 360), childTier));
+    }
+}
+
+int Simulation::findShootHit(const ShootState& shoot) const
+{
+    // Bigger meteors first, then the lowest slot, so the hit does not depend on the grid order
+    int hit = -1;
+
+    auto test = [&](int i)
+    {
+        if (!meteors.active[i] || !CirclesOverlap(shoot.position, shoot.radius, meteors.getPosition(i), meteors.radius[i])) return;
+
+        if (hit < 0 || meteors.tier[i] < meteors.tier[hit] || (meteors.tier[i] == meteors.tier[hit] && i < hit)) hit = i;
+    };
+
+    broadphase.query(shoot.position, shoot.radius, test);
+
+    // Fragments from earlier shots of this tick are not in the grid, there are only a few of them
+    for (int i : spawnedFragments) test(i);
+
+    return hit;
+}
+
+bool Simulation::checkShootCollisions()
+{
+    const int shootCount = shoots.getCapacity();
+    shootHits.assign(shootCount, -1);
+    spawnedFragments.clear();
+
+    // The queries only read the field, with a dense field each shot runs on its own job
+    const int chunk = (meteors.getActiveCount() >= parallelQueryMeteors) ? 1 : shootCount;
+
+    JobSystem::instance().parallelFor(shootCount, chunk, [&](int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            if (shoots.isActive(i)) shootHits[i] = findShootHit(shoots[i]);
+        }
+    });
+
+    // Hits are applied in shot order. Once one changed the field, the next shots
+    // look again so the result is the same as checking them one after the other
+    bool fieldChanged = false;
+
+    for (int shoot = 0; shoot < shootCount; shoot++)
+    {
+        if (!shoots.isActive(shoot)) continue;
+
+        const int hit = fieldChanged ? findShootHit(shoots[shoot]) : shootHits[shoot];
+        if (hit < 0) continue;
+
+        const float angle = shoots[shoot].rotation;
+        const int owner = shoots[shoot].owner;
+        releaseShoot(shoot);
+
+        pushEvent(SimEventType::MeteorDestroyed, meteors.getPosition(hit), owner);
+
+        if (meteors.tier[hit] + 1 < (int)tierRadius.size()) splitMeteor(hit, angle);
+
+        meteors.despawn(hit);
+        fieldChanged = true;
+    }
+
+    return fieldChanged;
+}
+
+Vector2 Simulation::interpolate(Vector2 previous, Vector2 current, float alpha) const
+{
+    // A jump of half the screen in one tick can only be a wraparound
+    if (fabsf(current.x - previous.x) > config.width * 0.5f || fabsf(current.y - previous.y) > config.height * 0.5f) return current;
+
+    return Vector2{ previous.x + (current.x - previous.x) * alpha, previous.y + (current.y - previous.y) * alpha };
+}
+
+#pragma region SNAPSHOT
+
+static const char snapshotMagic[4] = { 'A', 'X', 'D', 'S' };
+static const uint32_t snapshotVersion = 4;
+
+// Magic, version, payload size and payload checksum
+static const size_t snapshotHeaderSize = 16;
+
+// Fixed part of the payload, then the ships, the shoot pool and the meteor field
+static const size_t snapshotStateSize = 195;
+static const size_t snapshotShipSize = 56;
+static const size_t snapshotShootSize = 41;
+static const size_t snapshotMeteorSize = 33;
+
+// Both directions of a snapshot go through the same field lists, so save and load can not drift apart
+struct SnapshotOut
+{
+    ByteWriter& writer;
+
+    template<typename T>
+    void value(const T& v) { writer.write(v); }
+    void value(const bool& v) { writer.write((unsigned char)(v ? 1 : 0)); }
+    void value(const Vector2& v) { writer.write(v.x); writer.write(v.y); }
+};
+
+struct SnapshotIn
+{
+    ByteReader& reader;
+
+    template<typename T>
+    void value(T& v) { v = reader.read<T>(); }
+    void value(bool& v) { v = reader.read<unsigned char>() != 0; }
+    void value(Vector2& v) { v.x = reader.read<float>(); v.y = reader.read<float>(); }
+};
+
+template<typename Archive, typename Config>
+static void TransferConfig(Archive& archive, Config& config)
+{
+    archive.value(config.width);
+    archive.value(config.height);
+    archive.value(config.shipMaxShoots);
+    archive.value(config.shipMaxShield);
+    archive.value(config.shipRadius);
+    archive.value(config.shipMaxVelocity);
+    archive.value(config.shipMaxAcceleration);
+    archive.value(config.shipThrust);
+    archive.value(config.shipHitImpulse);
+    archive.value(config.shipHitInterval);
+    archive.value(config.shootRadius);
+    archive.value(config.shootSpeed);
+    archive.value(config.shootMaxLifeSpawn);
+    archive.value(config.meteorsSpeed);
+    archive.value(config.baseAmountBigMeteors);
+    archive.value(config.bigMeteorRadius);
+    archive.value(config.meteorSplitFactor);
+    archive.value(config.meteorTiers);
+    archive.value(config.meteorRadiusScale);
+    archive.value(config.stressMeteors);
+    archive.value(config.powerUpRespawnTime);
+}
+
+template<typename Archive, typename Ship>
+static void TransferShip(Archive& archive, Ship& ship)
+{
+    archive.value(ship.position);
+    archive.value(ship.previousPosition);
+    archive.value(ship.velocity);
+    archive.value(ship.dir);
+    archive.value(ship.acceleration);
+    archive.value(ship.rotation);
+    archive.value(ship.radius);
+    archive.value(ship.shield);
+    archive.value(ship.hitCooldown);
+    archive.value(ship.activeShoots);
+}
+
+template<typename Archive, typename PowerUp>
+static void TransferPowerUp(Archive& archive, PowerUp& powerUp)
+{
+    archive.value(powerUp.position);
+    archive.value(powerUp.previousPosition);
+    archive.value(powerUp.speed);
+    archive.value(powerUp.rotation);
+    archive.value(powerUp.radius);
+    archive.value(powerUp.timer);
+    archive.value(powerUp.active);
+}
+
+template<typename Archive, typename Shoot>
+static void TransferShoot(Archive& archive, Shoot& shoot)
+{
+    archive.value(shoot.position);
+    archive.value(shoot.previousPosition);
+    archive.value(shoot.speed);
+    archive.value(shoot.radius);
+    archive.value(shoot.rotation);
+    archive.value(shoot.lifeSpawn);
+    archive.value(shoot.active);
+    archive.value(shoot.owner);
+}
+
+static uint32_t SnapshotChecksum(const unsigned char* data, size_t size)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < size; i++) hash = (hash ^ data[i]) * 16777619u;
+
+    return hash;
+}
+
+// A free list is valid when it has count different slots inside [0, capacity)
+static bool ValidFreeList(const unsigned char* data, int count, int capacity, std::vector<unsigned char>& seen)
+{
+    ByteReader reader(data, (size_t)count * sizeof(int32_t));
+    seen.assign(capacity, 0);
+
+    for (int i = 0; i < count; i++)
+    {
+        const int32_t index = reader.read<int32_t>();
+        if (index < 0 || index >= capacity || seen[index]) return false;
+
+        seen[index] = 1;
+    }
+
+    return !reader.hasFailed();
+}
+
+// Every shot in the pool has to belong to one of the ships, releasing it updates the count of its owner
+static bool ValidShootOwners(const unsigned char* data, int capacity, int players)
+{
+    const size_t ownerOffset = snapshotShootSize - sizeof(int32_t);
+
+    for (int i = 0; i < capacity; i++)
+    {
+        ByteReader reader(data + (size_t)i * snapshotShootSize + ownerOffset, sizeof(int32_t));
+        const int32_t owner = reader.read<int32_t>();
+
+        if (owner < 0 || owner >= players) return false;
+    }
+
+    return true;
+}
+
+size_t Simulation::getSnapshotSize() const
+{
+    const int shootFree = shoots.getCapacity() - shoots.getCount();
+    const int meteorFree = meteors.size() - meteors.getActiveCount();
+
+    return snapshotHeaderSize + snapshotStateSize + ships.size() * snapshotShipSize
+        + (size_t)shoots.getCapacity() * snapshotShootSize + (size_t)shootFree * sizeof(int32_t)
+        + (size_t)meteors.getActiveCount() * snapshotMeteorSize + (size_t)meteorFree * sizeof(int32_t);
+}
+
+size_t Simulation::saveSnapshot(void* buffer, size_t capacity) const
+{
+    const size_t size = getSnapshotSize();
+    if (buffer == nullptr || capacity < size) return 0;
+
+    unsigned char* bytes = (unsigned char*)buffer;
+    ByteWriter writer(bytes + snapshotHeaderSize, size - snapshotHeaderSize);
+    SnapshotOut out{ writer };
+
+    const SlotAllocator& shootSlots = shoots.getSlots();
+    const SlotAllocator& meteorSlots = meteors.slots;
+
+    // Counts first, so load can check the size before touching anything
+    out.value((int32_t)shoots.getCapacity());
+    out.value((int32_t)(shoots.getCapacity() - shoots.getCount()));
+    out.value((int32_t)meteors.size());
+    out.value((int32_t)(meteors.size() - meteors.getActiveCount()));
+    out.value((int32_t)ships.size());
+
+    TransferConfig(out, config);
+    out.value((int32_t)level);
+    out.value(gameOver);
+    out.value(victory);
+    out.value((uint64_t)tick);
+    out.value(seed);
+    out.value(gameplayRandom.getState());
+    out.value(gameplayRandom.getIncrement());
+    out.value(cosmeticRandom.getState());
+    out.value(cosmeticRandom.getIncrement());
+    TransferPowerUp(out, hpPowerUp);
+    for (const ShipState& ship : ships) TransferShip(out, ship);
+
+    // Free slots in the order they will be handed out, that order decides where the next spawns land
+    for (int i = shootSlots.getFreeHead(); i >= 0; i = shootSlots.getNextFree(i)) out.value((int32_t)i);
+    for (const ShootState& shoot : shoots) TransferShoot(out, shoot);
+
+    for (int i = meteorSlots.getFreeHead(); i >= 0; i = meteorSlots.getNextFree(i)) out.value((int32_t)i);
+
+    for (int i = 0; i < meteors.size(); i++)
+    {
+        if (!meteors.active[i]) continue;
+
+        out.value(meteors.positionX[i]);
+        out.value(meteors.positionY[i]);
+        out.value(meteors.previousX[i]);
+        out.value(meteors.previousY[i]);
+        out.value(meteors.speedX[i]);
+        out.value(meteors.speedY[i]);
+        out.value(meteors.radius[i]);
+        out.value(meteors.rotation[i]);
+        out.value(meteors.tier[i]);
+    }
+
+    if (writer.hasOverflow() || writer.getSize() != size - snapshotHeaderSize) return 0;
+
+    const uint32_t payloadSize = (uint32_t)writer.getSize();
+    const uint32_t checksum = SnapshotChecksum(bytes + snapshotHeaderSize, payloadSize);
+
+    ByteWriter header(bytes, snapshotHeaderSize);
+    for (char c : snapshotMagic) header.write(c);
+    header.write(snapshotVersion);
+    header.write(payloadSize);
+    header.write(checksum);
+
+    return size;
+}
+
+bool Simulation::loadSnapshot(const void* buffer, size_t size)
+{
+    if (buffer == nullptr || size < snapshotHeaderSize + snapshotStateSize) return false;
+
+    const unsigned char* bytes = (const unsigned char*)buffer;
+    ByteReader header(bytes, snapshotHeaderSize);
+
+    for (char c : snapshotMagic)
+    {
+        if (header.read<char>() != c) return false;
+    }
+
+    if (header.read<uint32_t>() != snapshotVersion) return false;
+
+    const uint32_t payloadSize = header.read<uint32_t>();
+    const uint32_t checksum = header.read<uint32_t>();
+
+    if (payloadSize != size - snapshotHeaderSize) return false;
+    if (SnapshotChecksum(bytes + snapshotHeaderSize, payloadSize) != checksum) return false;
+
+    ByteReader reader(bytes + snapshotHeaderSize, payloadSize);
+    SnapshotIn in{ reader };
+
+    int32_t shootCapacity, shootFree, meteorCapacity, meteorFree, players;
+    in.value(shootCapacity);
+    in.value(shootFree);
+    in.value(meteorCapacity);
+    in.value(meteorFree);
+    in.value(players);
+
+    if (shootCapacity < 0 || shootFree < 0 || shootFree > shootCapacity) return false;
+    if (meteorCapacity < 0 || meteorFree < 0 || meteorFree > meteorCapacity) return false;
+    if (players < 1 || players > maxPlayers) return false;
+
+    const size_t expected = snapshotStateSize + (size_t)players * snapshotShipSize
+        + (size_t)shootCapacity * snapshotShootSize + (size_t)shootFree * sizeof(int32_t)
+        + (size_t)(meteorCapacity - meteorFree) * snapshotMeteorSize + (size_t)meteorFree * sizeof(int32_t);
+
+    if (expected != payloadSize) return false;
+
+    // The free lists and the shot owners are the only parts that can be invalid, they are checked before anything is assigned
+    const unsigned char* shootFreeList = bytes + snapshotHeaderSize + snapshotStateSize + (size_t)players * snapshotShipSize;
+    const unsigned char* shootPool = shootFreeList + (size_t)shootFree * sizeof(int32_t);
+    const unsigned char* meteorFreeList = shootPool + (size_t)shootCapacity * snapshotShootSize;
+
+    if (!ValidFreeList(shootFreeList, shootFree, shootCapacity, snapshotFreeSlots)) return false;
+    if (!ValidShootOwners(shootPool, shootCapacity, players)) return false;
+    if (!ValidFreeList(meteorFreeList, meteorFree, meteorCapacity, snapshotFreeSlots)) return false;
+
+    // From here on the snapshot is known to be whole and valid
+    TransferConfig(in, config);
+    config.players = players;
+    applyConfig();
+
+    int32_t savedLevel;
+    uint64_t savedTick;
+    in.value(savedLevel);
+    in.value(gameOver);
+    in.value(victory);
+    in.value(savedTick);
+    in.value(seed);
+    level = savedLevel;
+    tick = savedTick;
+
+    uint64_t gameplayState, gameplayIncrement, cosmeticState, cosmeticIncrement;
+    in.value(gameplayState);
+    in.value(gameplayIncrement);
+    in.value(cosmeticState);
+    in.value(cosmeticIncrement);
+    gameplayRandom.restore(gameplayState, gameplayIncrement);
+    cosmeticRandom.restore(cosmeticState, cosmeticIncrement);
+
+    TransferPowerUp(in, hpPowerUp);
+
+    ships.resize(players);
+    for (ShipState& ship : ships) TransferShip(in, ship);
+
+    bool slotsValid = shoots.restore(shootCapacity, shootFree, [&](int) { return (int)reader.read<int32_t>(); });
+    for (ShootState& shoot : shoots) TransferShoot(in, shoot);
+
+    // Shrinking keeps the memory, restoring an older snapshot and playing forward again does not allocate
+    meteors.resize(meteorCapacity);
+    slotsValid = meteors.slots.restore(meteorCapacity, meteorFree, [&](int) { return (int)reader.read<int32_t>(); }) && slotsValid;
+
+    for (int i = 0; i < meteorCapacity; i++)
+    {
+        meteors.active[i] = meteors.slots.isUsed(i) ? 1 : 0;
+        if (!meteors.active[i]) continue;
+
+        in.value(meteors.positionX[i]);
+        in.value(meteors.positionY[i]);
+        in.value(meteors.previousX[i]);
+        in.value(meteors.previousY[i]);
+        in.value(meteors.speedX[i]);
+        in.value(meteors.speedY[i]);
+        in.value(meteors.radius[i]);
+        in.value(meteors.rotation[i]);
+        in.value(meteors.tier[i]);
+    }
+
+    events.clear();
+    broadphase.build(meteors);
+
+    return slotsValid && !reader.hasFailed() && reader.getRemaining() == 0;
+}
+
+#pragma endregion
+
+#pragma region GETTERS
+
+const SimConfig& Simulation::getConfig() const
+{
+    return config;
+}
+
+int Simulation::getLevel() const
+{
+    return level;
+}
+
+bool Simulation::isGameOver() const
+{
+    return gameOver;
+}
+
+bool Simulation::isVictory() const
+{
+    return victory;
+}
+
+unsigned long long Simulation::getTick() const
+{
+    return tick;
+}
+
+uint64_t Simulation::getSeed() const
+{
+    return seed;
+}
+
+int Simulation::getPlayerCount() const
+{
+    return (int)ships.size();
+}
+
+const ShipState& Simulation::getShip(int player) const
+{
+    return ships[player];
+}
+
+const PowerUpState& Simulation::getPowerUp() const
+{
+    return hpPowerUp;
+}
+
+const Pool<ShootState>& Simulation::getShoots() const
+{
+    return shoots;
+}
+
+const MeteorField& Simulation::getMeteors() const
+{
+    return meteors;
+}
+
+const SpatialHash& Simulation::getBroadphase() const
+{
+    return broadphase;
+}
+
+const std::vector<SimEvent>& Simulation::getEvents() const
+{
+    return events;
+}
+
+#pragma endregion
@@ -0,0 +1,165 @@
+#pragma once
+#include <vector>
+#include "Simulation/SimTypes.h"
+#include "Simulation/MeteorField.h"
+#include "Simulation/SpatialHash.h"
+#include "Simulation/Random.h"
+#include "Utils/Pool.h"
+
+/// <summary>
+/// Estado y logica de una partida sin ventana, input ni audio.
+/// Avanza con un SimInput y un delta de tiempo explicitos, por lo que se puede
+/// correr headless (tests de carga, bots) a la velocidad que de la CPU.
+/// </summary>
+class Simulation
+{
+private:
+    SimConfig config;
+    int level = 1;
+    bool gameOver = false;
+    bool victory = false;
+    unsigned long long tick = 0;
+
+    // Gameplay draws (spawns, speeds, angles) and cosmetic draws (sfx pitch) use separate
+    // streams of the same seed, so adding an effect never changes how a match plays
+    static const uint64_t gameplayStream = 1;
+    static const uint64_t cosmeticStream = 2;
+    uint64_t seed = 0;
+    Random gameplayRandom;
+    Random cosmeticRandom;
+
+    std::vector<ShipState> ships;
+    PowerUpState hpPowerUp;
+    Pool<ShootState> shoots;
+    MeteorField meteors;
+    std::vector<float> tierRadius;
+
+    SpatialHash broadphase;
+    std::vector<int> contacts;
+    std::vector<int> shootHits;
+
+    // Slots split off by the shots of this tick, the grid was built before they existed
+    std::vector<int> spawnedFragments;
+
+    std::vector<SimEvent> events;
+
+    // Slots already seen while loadSnapshot checks a free list
+    std::vector<unsigned char> snapshotFreeSlots;
+
+private:
+    void applyConfig();
+    void pushEvent(SimEventType type, Vector2 position, int player);
+    void spawnBigMeteors(int count);
+    void updateShip(ShipState& ship, const SimInput& input, float dt);
+    void updatePowerUp(float dt);
+    void storePreviousPositions();
+    void fireShoot(int player);
+    void releaseShoot(int index);
+    void updateShoots(float dt);
+    void checkShipCollisions(float dt);
+    bool checkShootCollisions();
+    int findShootHit(const ShootState& shoot) const;
+    void splitMeteor(int parent, float angle);
+    void damageShip(int player, Vector2 hitPos);
+
+public:
+    // Most ships a match can have, the co-op mode uses all of them
+    static const int maxPlayers = 2;
+
+    Simulation(const SimConfig& config = SimConfig{});
+
+    /// <summary>
+    /// Cambia la configuracion, vale desde el proximo reset. Los arrays de la partida anterior
+    /// se reutilizan, asi cambiar de nivel o de modo no vuelve a reservar memoria
+    /// </summary>
+    /// <param name="config"></param>
+    void setConfig(const SimConfig& config);
+
+    /// <summary>
+    /// Reinicia la partida en el nivel indicado.
+    /// La misma semilla con la misma secuencia de SimInput da exactamente la misma partida.
+    /// </summary>
+    /// <param name="level"></param>
+    /// <param name="seed"></param>
+    void reset(int level, uint64_t seed);
+
+    /// <summary>
+    /// Avanza la simulacion un tick, solo con la entrada del primer jugador
+    /// </summary>
+    /// <param name="input">Entrada del jugador para este tick</param>
+    /// <param name="dt">Tiempo del tick en segundos</param>
+    void step(const SimInput& input, float dt);
+
+    /// <summary>
+    /// Avanza la simulacion un tick con la entrada de cada jugador.
+    /// Los jugadores sin entrada no aceleran, no disparan ni giran.
+    /// </summary>
+    /// <param name="inputs">Entrada de los jugadores [0, count)</param>
+    /// <param name="count"></param>
+    /// <param name="dt">Tiempo del tick en segundos</param>
+    void step(const SimInput inputs[], int count, float dt);
+
+    /// <summary>
+    /// Posicion para dibujar entre el tick anterior y el actual.
+    /// Si la entidad cruzo un borde de la pantalla no se interpola.
+    /// </summary>
+    /// <param name="previous">Posicion al inicio del ultimo tick</param>
+    /// <param name="current">Posicion al final del ultimo tick</param>
+    /// <param name="alpha">Fraccion del siguiente tick ya transcurrida [0, 1]</param>
+    /// <returns></returns>
+    Vector2 interpolate(Vector2 previous, Vector2 current, float alpha) const;
+
+    const SimConfig& getConfig() const;
+    int getLevel() const;
+    bool isGameOver() const;
+    bool isVictory() const;
+    unsigned long long getTick() const;
+    uint64_t getSeed() const;
+    int getPlayerCount() const;
+
+    /// <summary>
+    /// Nave del jugador, con el escudo en 0 o menos esta destruida y la partida sigue mientras quede otra
+    /// </summary>
+    /// <param name="player"></param>
+    /// <returns></returns>
+    const ShipState& getShip(int player = 0) const;
+    const PowerUpState& getPowerUp() const;
+    const Pool<ShootState>& getShoots() const;
+    const MeteorField& getMeteors() const;
+
+    /// <summary>
+    /// Grilla de los meteoros al final del ultimo step, incluidos los fragmentos que aparecieron en el
+    /// </summary>
+    /// <returns></returns>
+    const SpatialHash& getBroadphase() const;
+
+    /// <summary>
+    /// Bytes que ocupa el snapshot del estado actual, crece con los meteoros vivos
+    /// </summary>
+    /// <returns></returns>
+    size_t getSnapshotSize() const;
+
+    /// <summary>
+    /// Escribe todo el estado de la partida (configuracion, generadores, naves, disparos, meteoros y sus free-lists)
+    /// en el buffer, sin reservar memoria. Restaurarlo y seguir con los mismos SimInput da la misma partida
+    /// </summary>
+    /// <param name="buffer"></param>
+    /// <param name="capacity"></param>
+    /// <returns>Bytes escritos, 0 si no entra en capacity</returns>
+    size_t saveSnapshot(void* buffer, size_t capacity) const;
+
+    /// <summary>
+    /// Vuelve al estado de un snapshot de saveSnapshot. Solo reserva memoria si el snapshot tiene
+    /// mas slots de meteoros de los que el campo tuvo alguna vez. Los eventos del ultimo step se descartan
+    /// </summary>
+    /// <param name="buffer"></param>
+    /// <param name="size"></param>
+    /// <returns>false si no es un snapshot valido de esta version; uno truncado o corrupto se rechaza antes de tocar nada</returns>
+    bool loadSnapshot(const void* buffer, size_t size);
+
+    /// <summary>
+    /// Eventos generados en el ultimo step
+    /// </summary>
+    /// <returns></returns>
+    const std::vector<SimEvent>& getEvents() const;
+};
@@ -0,0 +1,124 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include "Utils/JobSystem.h"
+
+// Meteors binned by each job of build()
+static const int buildChunkSize = 16384;
+
+void SpatialHash::configure(float width, float height, float cellSize)
+{
+    this->cellSize = cellSize;
+    columns = (int)ceilf(width / cellSize);
+    rows = (int)ceilf(height / cellSize);
+
+    if (columns < 1) columns = 1;
+    if (rows < 1) rows = 1;
+
+    cellStart.assign(columns * rows + 1, 0);
+    entries.clear();
+}
+
+int SpatialHash::wrapColumn(int column) const
+{
+    column %= columns;
+    return (column < 0) ? column + columns : column;
+}
+
+int SpatialHash::wrapRow(int row) const
+{
+    row %= rows;
+    return (row < 0) ? row + rows : row;
+}
+
+void SpatialHash::build(const MeteorField& field)
+{
+    const int count = field.size();
+    const int cells = columns * rows;
+    const int chunks = std::max((count + buildChunkSize - 1) / buildChunkSize, 1);
+
+    cellStart.resize(cells + 1);
+    meteorCell.resize(count);
+    chunkCursor.assign(chunks * cells, 0);
+    chunkRadius.assign(chunks, 0.0f);
+
+    JobSystem& jobs = JobSystem::instance();
+
+    // Count the meteors of each cell, per chunk
+    jobs.parallelFor(chunks, 1, [&](int firstChunk, int lastChunk)
+    {
+        for (int chunk = firstChunk; chunk < lastChunk; chunk++)
+        {
+            int* counts = &chunkCursor[chunk * cells];
+            const int end = std::min((chunk + 1) * buildChunkSize, count);
+
+            for (int i = chunk * buildChunkSize; i < end; i++)
+            {
+                if (!field.active[i])
+                {
+                    meteorCell[i] = -1;
+                    continue;
+                }
+
+                const int column = wrapColumn((int)floorf(field.positionX[i] / cellSize));
+                const int row = wrapRow((int)floorf(field.positionY[i] / cellSize));
+                const int cell = row * columns + column;
+
+                meteorCell[i] = cell;
+                counts[cell]++;
+
+                if (field.radius[i] > chunkRadius[chunk]) chunkRadius[chunk] = field.radius[i];
+            }
+        }
+    });
+
+    // Inside a cell the chunks go in order, so each chunk starts writing where the previous ended
+    int total = 0;
+
+    for (int c = 0; c < cells; c++)
+    {
+        cellStart[c] = total;
+
+        for (int chunk = 0; chunk < chunks; chunk++)
+        {
+            const int meteors = chunkCursor[chunk * cells + c];
+            chunkCursor[chunk * cells + c] = total;
+            total += meteors;
+        }
+    }
+
+    cellStart[cells] = total;
+    maxRadius = *std::max_element(chunkRadius.begin(), chunkRadius.end());
+
+    // Scatter, walking each chunk in order keeps each cell sorted by index
+    entries.resize(total);
+
+    jobs.parallelFor(chunks, 1, [&](int firstChunk, int lastChunk)
+    {
+        for (int chunk = firstChunk; chunk < lastChunk; chunk++)
+        {
+            int* cursor = &chunkCursor[chunk * cells];
+            const int end = std::min((chunk + 1) * buildChunkSize, count);
+
+            for (int i = chunk * buildChunkSize; i < end; i++)
+            {
+                if (meteorCell[i] < 0) continue;
+                entries[cursor[meteorCell[i]]++] = i;
+            }
+        }
+    });
+}
+
+int SpatialHash::getColumns() const
+{
+    return columns;
+}
+
+int SpatialHash::getRows() const
+{
+    return rows;
+}
+
+float SpatialHash::getCellSize() const
+{
+    return cellSize;
+}
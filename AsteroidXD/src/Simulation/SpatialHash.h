@@ -0,0 +1,92 @@
+#pragma once
+#include <vector>
+#include "Simulation/MeteorField.h"
+
+/// <summary>
+/// Grilla uniforme sobre la pantalla para encontrar meteoros cercanos sin recorrer todo el campo.
+/// Las celdas se repiten como un toroide igual que el wraparound de los meteoros:
+/// lo que sale por un borde cae en las celdas del borde opuesto.
+/// </summary>
+class SpatialHash
+{
+private:
+    float cellSize = 80.0f;
+    int columns = 1;
+    int rows = 1;
+    float maxRadius = 0.0f;
+
+    // Counting sort of the active meteors by cell: the meteors of cell c are
+    // entries[cellStart[c]] .. entries[cellStart[c + 1] - 1], in field order
+    std::vector<int> cellStart;
+    std::vector<int> entries;
+    std::vector<int> meteorCell;
+
+    // The field is binned in chunks on the job system, each chunk has its own
+    // count (then write cursor) per cell: chunkCursor[chunk * cells + cell]
+    std::vector<int> chunkCursor;
+    std::vector<float> chunkRadius;
+
+private:
+    int wrapColumn(int column) const;
+    int wrapRow(int row) const;
+
+public:
+    /// <summary>
+    /// Define el tamano de la grilla, cellSize deberia ser al menos el diametro del meteoro mas grande
+    /// </summary>
+    void configure(float width, float height, float cellSize);
+
+    /// <summary>
+    /// Reparte los meteoros activos en las celdas, se llama cada tick despues de moverlos.
+    /// Con campos grandes se reparte entre hilos, el resultado es el mismo con cualquier cantidad.
+    /// </summary>
+    /// <param name="field"></param>
+    void build(const MeteorField& field);
+
+    /// <summary>
+    /// Llama a visit(indice) por cada meteoro cuya celda toca el circulo, sin repetir.
+    /// Es solo la fase ancha: el que llama hace el test exacto.
+    /// </summary>
+    template<typename Visitor>
+    void query(Vector2 center, float radius, Visitor&& visit) const
+    {
+        const float reach = radius + maxRadius;
+
+        int firstColumn = (int)floorf((center.x - reach) / cellSize);
+        int lastColumn = (int)floorf((center.x + reach) / cellSize);
+        int firstRow = (int)floorf((center.y - reach) / cellSize);
+        int lastRow = (int)floorf((center.y + reach) / cellSize);
+
+        // A query wider than the grid would visit the same cells twice
+        if (lastColumn - firstColumn + 1 > columns)
+        {
+            firstColumn = 0;
+            lastColumn = columns - 1;
+        }
+
+        if (lastRow - firstRow + 1 > rows)
+        {
+            firstRow = 0;
+            lastRow = rows - 1;
+        }
+
+        for (int row = firstRow; row <= lastRow; row++)
+        {
+            const int cellRow = wrapRow(row) * columns;
+
+            for (int column = firstColumn; column <= lastColumn; column++)
+            {
+                const int cell = cellRow + wrapColumn(column);
+
+                for (int e = cellStart[cell]; e < cellStart[cell + 1]; e++)
+                {
+                    visit(entries[e]);
+                }
+            }
+        }
+    }
+
+    int getColumns() const;
+    int getRows() const;
+    float getCellSize() const;
+};
@@ -0,0 +1,274 @@
+#include "VecEnv.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "Utils/JobSystem.h"
+#include "Utils/Profiler.h"
+
+// Envs stepped by each job, a few microseconds each so one job is tens of microseconds
+static const int envChunkSize = 16;
+
+// The ship only turns towards aim points farther than 40 pixels
+static const float aimDistance = 100.0f;
+
+static const int maxObservedMeteors = 32;
+static const int shipObservationSize = 8;
+static const int powerUpObservationSize = 3;
+static const int meteorObservationSize = 6;
+
+VecEnv::VecEnv(const VecEnvConfig& config) : config(config)
+{
+    this->config.sim.players = 1;
+    this->config.envs = std::max(config.envs, 1);
+    this->config.actionRepeat = std::max(config.actionRepeat, 1);
+    this->config.observedMeteors = std::min(std::max(config.observedMeteors, 0), maxObservedMeteors);
+
+    this->config.rays = std::max(config.rays, 0);
+
+    const int envs = this->config.envs;
+    observationSize = shipObservationSize + powerUpObservationSize + this->config.observedMeteors * meteorObservationSize + this->config.rays * 2;
+
+    simulations.reserve(envs);
+    for (int i = 0; i < envs; i++) simulations.emplace_back(this->config.sim);
+
+    // Each env casts with its own sensor, the candidate lists are scratch of the job that runs it
+    if (this->config.rays > 0)
+    {
+        sensors.reserve(envs);
+        for (int i = 0; i < envs; i++) sensors.emplace_back(this->config.rays, this->config.rayRange, this->config.sim);
+    }
+
+    observations.assign((size_t)envs * observationSize, 0.0f);
+    rewards.assign(envs, 0.0f);
+    dones.assign(envs, EnvDone::Running);
+    episodeSteps.assign(envs, 0);
+    episodes.assign(envs, 0);
+    episodeReturns.assign(envs, 0.0f);
+    finishedReturns.assign(envs, std::numeric_limits<float>::quiet_NaN());
+
+    reset();
+}
+
+void VecEnv::reset()
+{
+    PROFILE_SCOPE("VecEnv/Reset");
+
+    JobSystem::instance().parallelFor(config.envs, envChunkSize, [&](int begin, int end)
+    {
+        // Only the chunks that run on the main thread would be measured, the batch is one sample instead
+        PROFILE_SUSPEND();
+
+        for (int env = begin; env < end; env++)
+        {
+            resetEnv(env);
+            observe(env);
+
+            rewards[env] = 0.0f;
+            dones[env] = EnvDone::Running;
+            finishedReturns[env] = std::numeric_limits<float>::quiet_NaN();
+        }
+    });
+}
+
+void VecEnv::step(const float actions[])
+{
+    PROFILE_SCOPE("VecEnv/Step");
+
+    JobSystem::instance().parallelFor(config.envs, envChunkSize, [&](int begin, int end)
+    {
+        PROFILE_SUSPEND();
+
+        for (int env = begin; env < end; env++) stepEnv(env, actions + (size_t)env * actionSize);
+    });
+}
+
+void VecEnv::resetEnv(int env)
+{
+    // Every env and episode plays its own match, the same ones on every run
+    const uint64_t seed = config.seed + ((uint64_t)env << 32) + episodes[env];
+    episodes[env]++;
+
+    simulations[env].reset(config.level, seed);
+    episodeSteps[env] = 0;
+    episodeReturns[env] = 0.0f;
+}
+
+void VecEnv::stepEnv(int env, const float action[])
+{
+    Simulation& simulation = simulations[env];
+    const SimConfig& sim = simulation.getConfig();
+
+    const float aimX = cosf(action[0]);
+    const float aimY = sinf(action[0]);
+
+    SimInput input;
+    input.thrust = action[1] > 0.0f;
+    input.fire = action[2] > 0.0f;
+
+    float reward = 0.0f;
+    EnvDone done = EnvDone::Running;
+
+    for (int repeat = 0; repeat < config.actionRepeat; repeat++)
+    {
+        const ShipState& ship = simulation.getShip();
+        const int shield = std::max(ship.shield, 0);
+
+        // The ship moves between repeats, the aim point follows it
+        input.aim = Vector2{ ship.position.x + aimX * aimDistance, ship.position.y + aimY * aimDistance };
+
+        simulation.step(input, config.step);
+
+        // A held action is one press, it fires once
+        input.fire = false;
+
+        for (const SimEvent& e : simulation.getEvents())
+        {
+            if (e.type == SimEventType::MeteorDestroyed) reward += config.meteorReward;
+        }
+
+        reward += (float)(std::max(simulation.getShip().shield, 0) - shield) / sim.shipMaxShield * config.shieldReward;
+
+        if (simulation.isGameOver())
+        {
+            reward += config.deathReward;
+            done = EnvDone::GameOver;
+            break;
+        }
+
+        if (simulation.isVictory())
+        {
+            reward += config.clearReward;
+            done = EnvDone::Cleared;
+            break;
+        }
+    }
+
+    episodeSteps[env]++;
+    episodeReturns[env] += reward;
+
+    if (done == EnvDone::Running && episodeSteps[env] >= config.maxEpisodeSteps) done = EnvDone::Truncated;
+
+    rewards[env] = reward;
+    dones[env] = done;
+    finishedReturns[env] = (done != EnvDone::Running) ? episodeReturns[env] : std::numeric_limits<float>::quiet_NaN();
+
+    if (done != EnvDone::Running) resetEnv(env);
+
+    observe(env);
+}
+
+void VecEnv::observe(int env)
+{
+    const Simulation& simulation = simulations[env];
+    const SimConfig& sim = simulation.getConfig();
+    const ShipState& ship = simulation.getShip();
+
+    float* out = observations.data() + (size_t)env * observationSize;
+
+    // Ship, with the velocity and the nose in screen space (y grows down)
+    *out++ = ship.position.x / sim.width;
+    *out++ = ship.position.y / sim.height;
+    *out++ = ship.velocity.x / sim.shipMaxVelocity;
+    *out++ = -ship.velocity.y / sim.shipMaxVelocity;
+    *out++ = sinf(ship.rotation * DEG2RAD);
+    *out++ = -cosf(ship.rotation * DEG2RAD);
+    *out++ = (float)std::max(ship.shield, 0) / sim.shipMaxShield;
+    *out++ = (float)(sim.shipMaxShoots - ship.activeShoots) / sim.shipMaxShoots;
+
+    const PowerUpState& powerUp = simulation.getPowerUp();
+    *out++ = powerUp.active ? 1.0f : 0.0f;
+    *out++ = powerUp.active ? WrappedDelta(powerUp.position.x - ship.position.x, sim.width) / sim.width : 0.0f;
+    *out++ = powerUp.active ? WrappedDelta(powerUp.position.y - ship.position.y, sim.height) / sim.height : 0.0f;
+
+    // The nearest meteors by insertion into a short sorted list, a level holds a few dozen at most
+    const int wanted = config.observedMeteors;
+    int nearest[maxObservedMeteors];
+    float nearestDistance[maxObservedMeteors];
+    int found = 0;
+
+    const MeteorField& meteors = simulation.getMeteors();
+
+    for (int i = 0; i < meteors.size() && wanted > 0; i++)
+    {
+        if (!meteors.active[i]) continue;
+
+        const float dx = WrappedDelta(meteors.positionX[i] - ship.position.x, sim.width);
+        const float dy = WrappedDelta(meteors.positionY[i] - ship.position.y, sim.height);
+        const float distance = dx * dx + dy * dy;
+
+        if (found == wanted && distance >= nearestDistance[found - 1]) continue;
+
+        int slot = (found < wanted) ? found++ : found - 1;
+
+        for (; slot > 0 && nearestDistance[slot - 1] > distance; slot--)
+        {
+            nearest[slot] = nearest[slot - 1];
+            nearestDistance[slot] = nearestDistance[slot - 1];
+        }
+
+        nearest[slot] = i;
+        nearestDistance[slot] = distance;
+    }
+
+    for (int k = 0; k < wanted; k++)
+    {
+        if (k >= found)
+        {
+            for (int f = 0; f < meteorObservationSize; f++) *out++ = 0.0f;
+            continue;
+        }
+
+        const int i = nearest[k];
+
+        *out++ = 1.0f;
+        *out++ = WrappedDelta(meteors.positionX[i] - ship.position.x, sim.width) / sim.width;
+        *out++ = WrappedDelta(meteors.positionY[i] - ship.position.y, sim.height) / sim.height;
+        *out++ = meteors.speedX[i] / sim.meteorsSpeed;
+        *out++ = meteors.speedY[i] / sim.meteorsSpeed;
+        *out++ = meteors.radius[i] / sim.bigMeteorRadius;
+    }
+
+    if (!sensors.empty())
+    {
+        sensors[env].cast(simulation, 0, out, out + config.rays);
+    }
+}
+
+#pragma region GETTERS
+
+int VecEnv::getEnvCount() const
+{
+    return config.envs;
+}
+
+int VecEnv::getObservationSize() const
+{
+    return observationSize;
+}
+
+const float* VecEnv::getObservations() const
+{
+    return observations.data();
+}
+
+const float* VecEnv::getRewards() const
+{
+    return rewards.data();
+}
+
+const EnvDone* VecEnv::getDones() const
+{
+    return dones.data();
+}
+
+const float* VecEnv::getFinishedReturns() const
+{
+    return finishedReturns.data();
+}
+
+const Simulation& VecEnv::getSimulation(int env) const
+{
+    return simulations[env];
+}
+
+#pragma endregion
@@ -0,0 +1,124 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Simulation/RaySensor.h"
+#include "Simulation/Simulation.h"
+
+/// <summary>
+/// Parametros de VecEnv, iguales para todos los entornos
+/// </summary>
+struct VecEnvConfig
+{
+    int envs = 64;
+    SimConfig sim;
+    int level = 1;
+    uint64_t seed = 0;
+
+    // Seconds per tick, and ticks each action is held for
+    float step = 1.0f / 60.0f;
+    int actionRepeat = 1;
+
+    // An episode that lasts this many steps is cut, the env reports it as truncated
+    int maxEpisodeSteps = 3600;
+
+    // Meteors in the observation, the nearest ones first
+    int observedMeteors = 8;
+
+    // Rays around the ship with the distance to the nearest meteor and power-up, none by default
+    int rays = 0;
+    float rayRange = 300.0f;
+
+    // Reward: per meteor destroyed, per full shield lost or recovered, and at the end of the episode
+    float meteorReward = 1.0f;
+    float shieldReward = 1.0f;
+    float clearReward = 10.0f;
+    float deathReward = -10.0f;
+};
+
+/// <summary>
+/// Por que termino el episodio de un entorno en el ultimo step
+/// </summary>
+enum class EnvDone : unsigned char
+{
+    Running = 0,
+    GameOver = 1,
+    Cleared = 2,
+    Truncated = 3
+};
+
+/// <summary>
+/// Muchas partidas de un jugador que avanzan juntas, para entrenar bots sin ventana.
+/// Las acciones, observaciones, recompensas y finales son arrays contiguos de todos los entornos,
+/// el entorno i ocupa [i * size, (i + 1) * size). Los entornos se reparten entre los hilos del JobSystem
+/// y cada uno solo escribe su parte, asi el resultado no depende de la cantidad de hilos.
+/// Un entorno que termina vuelve a empezar solo: su observacion ya es la del episodio nuevo.
+/// </summary>
+class VecEnv
+{
+public:
+    // Aim angle in radians (0 looks right, growing clockwise on screen), thrust and fire (on when above 0)
+    static const int actionSize = 3;
+
+private:
+    VecEnvConfig config;
+    int observationSize;
+
+    std::vector<Simulation> simulations;
+    std::vector<RaySensor> sensors;
+    std::vector<float> observations;
+    std::vector<float> rewards;
+    std::vector<EnvDone> dones;
+
+    std::vector<int> episodeSteps;
+    std::vector<uint32_t> episodes;
+    std::vector<float> episodeReturns;
+
+    // Returns of the episodes that ended in the last step, NaN where none did
+    std::vector<float> finishedReturns;
+
+private:
+    void resetEnv(int env);
+    void stepEnv(int env, const float action[]);
+    void observe(int env);
+
+public:
+    VecEnv(const VecEnvConfig& config = VecEnvConfig{});
+
+    /// <summary>
+    /// Empieza un episodio nuevo en todos los entornos
+    /// </summary>
+    void reset();
+
+    /// <summary>
+    /// Avanza todos los entornos con una accion cada uno
+    /// </summary>
+    /// <param name="actions">getEnvCount() * actionSize floats</param>
+    void step(const float actions[]);
+
+    int getEnvCount() const;
+    int getObservationSize() const;
+
+    /// <summary>
+    /// getEnvCount() * getObservationSize() floats: la nave (posicion, velocidad, direccion y escudo),
+    /// el power-up y los meteoros mas cercanos, todo relativo a la nave y normalizado, y si hay rayos
+    /// la distancia que mide cada uno al meteoro y despues al power-up (ver RaySensor).
+    /// Los desplazamientos tienen en cuenta que la pantalla da la vuelta.
+    /// </summary>
+    /// <returns></returns>
+    const float* getObservations() const;
+
+    /// <summary>
+    /// Recompensa de cada entorno en el ultimo step
+    /// </summary>
+    /// <returns></returns>
+    const float* getRewards() const;
+    const EnvDone* getDones() const;
+
+    /// <summary>
+    /// Recompensa total del episodio que termino en el ultimo step, NaN en los entornos que siguen
+    /// </summary>
+    /// <returns></returns>
+    const float* getFinishedReturns() const;
+
+    const Simulation& getSimulation(int env) const;
+};
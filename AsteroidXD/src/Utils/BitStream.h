@@ -0,0 +1,128 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// Escribe valores de cualquier cantidad de bits (1 a 32) seguidos en un buffer de quien llama, sin reservar memoria.
+/// Como ByteWriter, lo que no entra queda marcado y se revisa al final; rewind vuelve a una marca para
+/// descartar lo ultimo escrito, asi se puede cortar un paquete justo antes del valor que no entro.
+/// </summary>
+class BitWriter
+{
+private:
+    unsigned char* data;
+    size_t capacityBits;
+    size_t position = 0;
+    bool overflow = false;
+
+public:
+    BitWriter(void* data, size_t capacity) : data((unsigned char*)data), capacityBits(capacity * 8) { }
+
+    void write(uint32_t value, int bits)
+    {
+        if (overflow || capacityBits - position < (size_t)bits)
+        {
+            overflow = true;
+            return;
+        }
+
+        // Least significant bit first, a byte at a time
+        for (int written = 0; written < bits;)
+        {
+            const size_t byte = position >> 3;
+            const int offset = (int)(position & 7);
+            const int count = (bits - written < 8 - offset) ? bits - written : 8 - offset;
+            const unsigned mask = (1u << count) - 1;
+
+            // The bits above offset are cleared too, they may hold something written before a rewind
+            data[byte] = (unsigned char)((data[byte] & ((1u << offset) - 1)) | (((value >> written) & mask) << offset));
+
+            written += count;
+            position += count;
+        }
+    }
+
+    void writeBool(bool value) { write(value ? 1 : 0, 1); }
+
+    /// <summary>
+    /// Reemplaza bits ya escritos sin tocar los que siguen, para completar un campo reservado
+    /// cuando se conoce su valor (por ejemplo cuantos elementos entraron en el paquete)
+    /// </summary>
+    /// <param name="at">Posicion del campo, de getPosition antes de reservarlo</param>
+    /// <param name="value"></param>
+    /// <param name="bits"></param>
+    void overwrite(size_t at, uint32_t value, int bits)
+    {
+        if (at + bits > position) return;
+
+        for (int i = 0; i < bits; i++)
+        {
+            const size_t byte = (at + i) >> 3;
+            const int offset = (int)((at + i) & 7);
+
+            data[byte] = (unsigned char)((data[byte] & ~(1u << offset)) | (((value >> i) & 1u) << offset));
+        }
+    }
+
+    size_t getPosition() const { return position; }
+
+    /// <summary>
+    /// Vuelve a una posicion anterior de getPosition, tambien borra la marca de overflow
+    /// </summary>
+    /// <param name="mark"></param>
+    void rewind(size_t mark)
+    {
+        position = mark;
+        overflow = false;
+    }
+
+    // Bytes used, the last one padded with zeros
+    size_t getSize() const { return (position + 7) >> 3; }
+    bool hasOverflow() const { return overflow; }
+};
+
+/// <summary>
+/// Lee lo que escribio BitWriter, leer mas alla del final devuelve ceros y queda marcado
+/// </summary>
+class BitReader
+{
+private:
+    const unsigned char* data;
+    size_t sizeBits;
+    size_t position = 0;
+    bool failed = false;
+
+public:
+    BitReader(const void* data, size_t size) : data((const unsigned char*)data), sizeBits(size * 8) { }
+
+    uint32_t read(int bits)
+    {
+        if (failed || sizeBits - position < (size_t)bits)
+        {
+            failed = true;
+            return 0;
+        }
+
+        uint32_t value = 0;
+
+        for (int done = 0; done < bits;)
+        {
+            const size_t byte = position >> 3;
+            const int offset = (int)(position & 7);
+            const int count = (bits - done < 8 - offset) ? bits - done : 8 - offset;
+            const unsigned mask = (1u << count) - 1;
+
+            value |= (uint32_t)((data[byte] >> offset) & mask) << done;
+
+            done += count;
+            position += count;
+        }
+
+        return value;
+    }
+
+    bool readBool() { return read(1) != 0; }
+
+    size_t getRemainingBits() const { return sizeBits - position; }
+    bool hasFailed() const { return failed; }
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/// <summary>
+/// Escribe valores sueltos en un buffer de quien llama, sin reservar memoria.
+/// Si algo no entra deja de escribir y queda marcado, se revisa una sola vez al final.
+/// </summary>
+class ByteWriter
+{
+private:
+    unsigned char* data;
+    size_t capacity;
+    size_t size = 0;
+    bool overflow = false;
+
+public:
+    ByteWriter(void* data, size_t capacity) : data((unsigned char*)data), capacity(capacity) { }
+
+    template<typename T>
+    void write(const T& value)
+    {
+        if (overflow || capacity - size < sizeof(T))
+        {
+            overflow = true;
+            return;
+        }
+
+        // memcpy, the buffer has no alignment guarantees
+        if (data != nullptr) memcpy(data + size, &value, sizeof(T));
+        size += sizeof(T);
+    }
+
+    size_t getSize() const { return size; }
+    bool hasOverflow() const { return overflow; }
+};
+
+/// <summary>
+/// Lee lo que escribio ByteWriter, leer mas alla del final devuelve ceros y queda marcado
+/// </summary>
+class ByteReader
+{
+private:
+    const unsigned char* data;
+    size_t size;
+    size_t offset = 0;
+    bool failed = false;
+
+public:
+    ByteReader(const void* data, size_t size) : data((const unsigned char*)data), size(size) { }
+
+    template<typename T>
+    T read()
+    {
+        T value{};
+
+        if (failed || size - offset < sizeof(T))
+        {
+            failed = true;
+            return value;
+        }
+
+        memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+
+        return value;
+    }
+
+    size_t getOffset() const { return offset; }
+    size_t getRemaining() const { return size - offset; }
+    bool hasFailed() const { return failed; }
+};
@@ -0,0 +1,22 @@
+#include "Console.h"
+#include <cstdio>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+void AttachConsoleOutput()
+{
+#ifdef _WIN32
+    // A console build already writes to one
+    if (GetConsoleWindow() != nullptr) return;
+
+    if (!AttachConsole(ATTACH_PARENT_PROCESS) && !AllocConsole()) return;
+
+    FILE* stream = nullptr;
+    freopen_s(&stream, "CONOUT$", "w", stdout);
+    freopen_s(&stream, "CONOUT$", "w", stderr);
+#endif
+}
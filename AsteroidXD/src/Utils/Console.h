@@ -0,0 +1,12 @@
+#pragma once
+
+#pragma region FUNCTIONS
+
+/// <summary>
+/// En Windows el Release no tiene consola (subsystem Windows): engancha stdout y stderr a la consola
+/// desde la que se lanzo el proceso, o abre una nueva si no hay ninguna. En otros sistemas no hace nada.
+/// No incluye raylib (windows.h choca con sus nombres).
+/// </summary>
+void AttachConsoleOutput();
+
+#pragma endregion
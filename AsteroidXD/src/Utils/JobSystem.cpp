@@ -0,0 +1,157 @@
+#include "JobSystem.h"
+
+// Queue of the current thread: workers get 1..n, every other thread shares 0
+static thread_local int workerQueue = 0;
+
+JobSystem& JobSystem::instance()
+{
+    static JobSystem jobSystem;
+    return jobSystem;
+}
+
+JobSystem::~JobSystem()
+{
+    stop();
+}
+
+void JobSystem::start(int workerCount)
+{
+    stop();
+
+    if (workerCount < 0) workerCount = std::max((int)std::thread::hardware_concurrency() - 1, 0);
+
+    queues.clear();
+    for (int i = 0; i <= workerCount; i++) queues.emplace_back(new WorkQueue());
+
+    running = true;
+
+    for (int i = 1; i <= workerCount; i++)
+    {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+void JobSystem::stop()
+{
+    if (!running) return;
+
+    // Whatever is still queued runs on this thread before the workers go away
+    while (queued > 0) runOne(currentQueue());
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+
+    wake.notify_all();
+
+    for (std::thread& worker : workers) worker.join();
+    workers.clear();
+}
+
+int JobSystem::getWorkerCount() const
+{
+    return (int)workers.size();
+}
+
+int JobSystem::currentQueue() const
+{
+    return (workerQueue < (int)queues.size()) ? workerQueue : 0;
+}
+
+void JobSystem::submit(JobCounter& counter, std::function<void()> job)
+{
+    counter.pending.fetch_add(1);
+
+    if (queues.empty())
+    {
+        job();
+        counter.pending.fetch_sub(1);
+        return;
+    }
+
+    WorkQueue& queue = *queues[currentQueue()];
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(Job{ std::move(job), &counter });
+    }
+
+    queued.fetch_add(1);
+
+    // Taking the lock orders this notify after a worker that is about to sleep checked queued
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+
+    wake.notify_one();
+}
+
+bool JobSystem::popLocal(int queue, Job& job)
+{
+    WorkQueue& own = *queues[queue];
+    std::lock_guard<std::mutex> lock(own.mutex);
+
+    if (own.jobs.empty()) return false;
+
+    // Newest first: its data is the most likely to still be in cache
+    job = std::move(own.jobs.back());
+    own.jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::steal(int thief, Job& job)
+{
+    const int count = (int)queues.size();
+
+    for (int i = 1; i < count; i++)
+    {
+        WorkQueue& victim = *queues[(thief + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (victim.jobs.empty()) continue;
+
+        // Oldest first: the owner keeps working on the other end
+        job = std::move(victim.jobs.front());
+        victim.jobs.pop_front();
+        return true;
+    }
+
+    return false;
+}
+
+bool JobSystem::runOne(int queue)
+{
+    Job job;
+
+    if (!popLocal(queue, job) && !steal(queue, job)) return false;
+
+    queued.fetch_sub(1);
+    job.run();
+    job.counter->pending.fetch_sub(1, std::memory_order_release);
+
+    return true;
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    const int queue = currentQueue();
+
+    while (counter.pending.load(std::memory_order_acquire) > 0)
+    {
+        if (!runOne(queue)) std::this_thread::yield();
+    }
+}
+
+void JobSystem::workerLoop(int queue)
+{
+    workerQueue = queue;
+
+    while (running)
+    {
+        if (runOne(queue)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return queued > 0 || !running; });
+    }
+}
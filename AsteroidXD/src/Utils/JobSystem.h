@@ -0,0 +1,121 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// Cuenta los trabajos pendientes de un grupo, JobSystem::wait espera a que llegue a 0
+/// </summary>
+struct JobCounter
+{
+    std::atomic<int> pending{ 0 };
+};
+
+/// <summary>
+/// Planificador de tareas con work stealing: cada hilo tiene su propia cola,
+/// saca trabajo del final de la suya y, si esta vacia, roba del principio de las otras.
+/// El hilo que espera un grupo tambien ejecuta trabajos, asi que se puede anidar.
+/// Sin workers (o con pocos elementos) todo corre en el hilo que llama.
+/// </summary>
+class JobSystem
+{
+private:
+    struct Job
+    {
+        std::function<void()> run;
+        JobCounter* counter;
+    };
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::thread> workers;
+
+    // queues[0] belongs to the threads that are not workers (the main thread)
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+
+    std::atomic<bool> running{ false };
+    std::atomic<int> queued{ 0 };
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+private:
+    JobSystem() = default;
+
+    int currentQueue() const;
+    bool popLocal(int queue, Job& job);
+    bool steal(int thief, Job& job);
+    bool runOne(int queue);
+    void workerLoop(int queue);
+
+public:
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    ~JobSystem();
+
+    static JobSystem& instance();
+
+    /// <summary>
+    /// Arranca los hilos de trabajo
+    /// </summary>
+    /// <param name="workerCount">Cantidad de workers, -1 usa un hilo por core menos el principal</param>
+    void start(int workerCount = -1);
+
+    /// <summary>
+    /// Termina los trabajos encolados y detiene los hilos
+    /// </summary>
+    void stop();
+
+    int getWorkerCount() const;
+
+    /// <summary>
+    /// Encola un trabajo en la cola del hilo actual
+    /// </summary>
+    /// <param name="counter">Grupo al que pertenece el trabajo</param>
+    /// <param name="job"></param>
+    void submit(JobCounter& counter, std::function<void()> job);
+
+    /// <summary>
+    /// Ejecuta trabajos (propios o robados) hasta que el grupo termina
+    /// </summary>
+    /// <param name="counter"></param>
+    void wait(JobCounter& counter);
+
+    /// <summary>
+    /// Llama a body(begin, end) para cada bloque de chunkSize elementos de [0, count)
+    /// y vuelve cuando terminaron todos. El hilo que llama procesa el primer bloque.
+    /// Cada bloque solo debe escribir sus propios elementos para que el resultado no
+    /// dependa de la cantidad de hilos.
+    /// </summary>
+    template<typename Body>
+    void parallelFor(int count, int chunkSize, const Body& body)
+    {
+        if (count <= 0) return;
+
+        if (workers.empty() || count <= chunkSize)
+        {
+            body(0, count);
+            return;
+        }
+
+        JobCounter counter;
+
+        for (int begin = chunkSize; begin < count; begin += chunkSize)
+        {
+            const int end = std::min(begin + chunkSize, count);
+            submit(counter, [&body, begin, end]() { body(begin, end); });
+        }
+
+        body(0, chunkSize);
+        wait(counter);
+    }
+};
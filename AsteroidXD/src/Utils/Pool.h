@@ -0,0 +1,204 @@
+#pragma once
+#include <vector>
+
+/// <summary>
+/// Reparte los indices [0, capacidad) con una free-list.
+/// acquire y release son O(1) y despues de reset no reservan memoria.
+/// </summary>
+class SlotAllocator
+{
+private:
+    std::vector<int> nextFree;
+    std::vector<unsigned char> used;
+    int freeHead = -1;
+    int usedCount = 0;
+
+public:
+    /// <summary>
+    /// Libera todos los indices y fija la capacidad
+    /// </summary>
+    /// <param name="capacity"></param>
+    void reset(int capacity)
+    {
+        nextFree.resize(capacity);
+        used.assign(capacity, 0);
+
+        // The list starts in index order, so a fresh pool hands out 0, 1, 2...
+        for (int i = 0; i < capacity; i++) nextFree[i] = (i + 1 < capacity) ? i + 1 : -1;
+
+        freeHead = (capacity > 0) ? 0 : -1;
+        usedCount = 0;
+    }
+
+    /// <summary>
+    /// Agrega indices libres hasta llegar a capacity, los que estan en uso no cambian
+    /// </summary>
+    /// <param name="capacity"></param>
+    void grow(int capacity)
+    {
+        const int oldCapacity = getCapacity();
+        if (capacity <= oldCapacity) return;
+
+        nextFree.resize(capacity);
+        used.resize(capacity, 0);
+
+        // The new indices go first, in order, and then whatever was already free
+        for (int i = oldCapacity; i < capacity; i++) nextFree[i] = (i + 1 < capacity) ? i + 1 : freeHead;
+
+        freeHead = oldCapacity;
+    }
+
+    /// <summary>
+    /// Toma un indice libre
+    /// </summary>
+    /// <returns>El indice o -1 si no queda ninguno</returns>
+    int acquire()
+    {
+        if (freeHead < 0) return -1;
+
+        const int index = freeHead;
+        freeHead = nextFree[index];
+        used[index] = 1;
+        usedCount++;
+
+        return index;
+    }
+
+    /// <summary>
+    /// Devuelve el indice a la lista, liberar dos veces no hace nada
+    /// </summary>
+    /// <param name="index"></param>
+    void release(int index)
+    {
+        if (!used[index]) return;
+
+        used[index] = 0;
+        nextFree[index] = freeHead;
+        freeHead = index;
+        usedCount--;
+    }
+
+    /// <summary>
+    /// Rearma la free-list para restaurar un snapshot: freeIndex(i) es el i-esimo indice libre,
+    /// en el orden en que se van a entregar, el resto queda en uso. No reserva memoria si la capacidad no crece.
+    /// </summary>
+    /// <param name="capacity"></param>
+    /// <param name="freeCount"></param>
+    /// <param name="freeIndex"></param>
+    /// <returns>false si un indice esta fuera de rango o repetido, la lista queda vacia</returns>
+    template<typename FreeIndex>
+    bool restore(int capacity, int freeCount, FreeIndex&& freeIndex)
+    {
+        nextFree.resize(capacity);
+        used.assign(capacity, 1);
+        freeHead = -1;
+        usedCount = capacity;
+
+        int tail = -1;
+
+        for (int i = 0; i < freeCount; i++)
+        {
+            const int index = freeIndex(i);
+
+            if (index < 0 || index >= capacity || !used[index])
+            {
+                used.assign(capacity, 1);
+                freeHead = -1;
+                usedCount = capacity;
+                return false;
+            }
+
+            used[index] = 0;
+            nextFree[index] = -1;
+
+            if (tail < 0) freeHead = index;
+            else nextFree[tail] = index;
+
+            tail = index;
+            usedCount--;
+        }
+
+        return true;
+    }
+
+    bool isUsed(int index) const { return used[index] != 0; }
+    int getCapacity() const { return (int)used.size(); }
+    int getCount() const { return usedCount; }
+
+    // Free-list walk, -1 ends it
+    int getFreeHead() const { return freeHead; }
+    int getNextFree(int index) const { return nextFree[index]; }
+};
+
+/// <summary>
+/// Pool de capacidad fija: los objetos viven en un solo bloque contiguo
+/// y se reciclan con la free-list de SlotAllocator, sin new/delete por objeto.
+/// Recorrerlo con for visita todos los slots, activos o no.
+/// </summary>
+template<typename T>
+class Pool
+{
+private:
+    std::vector<T> items;
+    SlotAllocator slots;
+
+public:
+    typedef typename std::vector<T>::iterator iterator;
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
+    /// <summary>
+    /// Descarta todo y deja capacity copias de value, todas libres
+    /// </summary>
+    /// <param name="capacity"></param>
+    /// <param name="value"></param>
+    void reset(int capacity, const T& value = T{})
+    {
+        items.assign(capacity, value);
+        slots.reset(capacity);
+    }
+
+    /// <summary>
+    /// Agrega slots libres, reserva memoria y puede mover los objetos
+    /// </summary>
+    /// <param name="capacity"></param>
+    /// <param name="value"></param>
+    void grow(int capacity, const T& value = T{})
+    {
+        if (capacity <= getCapacity()) return;
+
+        items.resize(capacity, value);
+        slots.grow(capacity);
+    }
+
+    /// <summary>
+    /// Toma un slot libre, el objeto conserva lo que tenia al liberarse
+    /// </summary>
+    /// <returns>El indice o -1 si el pool esta lleno</returns>
+    int acquire() { return slots.acquire(); }
+    void release(int index) { slots.release(index); }
+
+    /// <summary>
+    /// Para restaurar un snapshot: deja capacity slots con la free-list de SlotAllocator::restore,
+    /// los objetos se cargan despues con operator[]
+    /// </summary>
+    template<typename FreeIndex>
+    bool restore(int capacity, int freeCount, FreeIndex&& freeIndex)
+    {
+        items.resize(capacity);
+        return slots.restore(capacity, freeCount, freeIndex);
+    }
+
+    const SlotAllocator& getSlots() const { return slots; }
+
+    bool isActive(int index) const { return slots.isUsed(index); }
+    int getCapacity() const { return slots.getCapacity(); }
+    int getCount() const { return slots.getCount(); }
+
+    T& operator[](int index) { return items[index]; }
+    const T& operator[](int index) const { return items[index]; }
+
+    iterator begin() { return items.begin(); }
+    iterator end() { return items.end(); }
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+};
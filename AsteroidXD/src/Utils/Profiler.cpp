@@ -0,0 +1,144 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <thread>
+
+static uint64_t SteadyNanoseconds()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Static initialization runs on the main thread, before main and before any job system worker exists
+static const std::thread::id mainThread = std::this_thread::get_id();
+
+Profiler::Profiler() : samples(capacity), origin(SteadyNanoseconds()) { }
+
+Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+uint64_t Profiler::now() const
+{
+    return SteadyNanoseconds() - origin;
+}
+
+uint32_t Profiler::enter()
+{
+    // Simulations stepped on job system workers (servers, VecEnv) are not measured, the buffer is not shared
+    if (std::this_thread::get_id() != mainThread || suspended > 0) return depth;
+
+    return depth++;
+}
+
+void Profiler::leave(const char* name, uint64_t start, uint32_t depth)
+{
+    if (std::this_thread::get_id() != mainThread || suspended > 0) return;
+
+    this->depth = depth;
+
+    // Oldest samples are overwritten once the buffer is full
+    samples[head] = ProfileSample{ name, frame, depth, start, now() - start };
+    head = (head + 1) % capacity;
+    if (count < capacity) count++;
+}
+
+void Profiler::nextFrame()
+{
+    frame++;
+}
+
+void Profiler::suspend()
+{
+    if (std::this_thread::get_id() == mainThread) suspended++;
+}
+
+void Profiler::resume()
+{
+    if (std::this_thread::get_id() == mainThread) suspended--;
+}
+
+void Profiler::clear()
+{
+    head = 0;
+    count = 0;
+}
+
+const ProfileSample& Profiler::at(int index) const
+{
+    // index 0 is the oldest sample still in the buffer
+    return samples[(head - count + index + capacity) % capacity];
+}
+
+std::vector<ProfileSummary> Profiler::summarize() const
+{
+    std::map<std::string, std::vector<double>> durations;
+
+    for (int i = 0; i < count; i++)
+    {
+        const ProfileSample& sample = at(i);
+        durations[sample.name].push_back((double)sample.duration / 1000000.0);
+    }
+
+    std::vector<ProfileSummary> summary;
+
+    for (auto& phase : durations)
+    {
+        std::vector<double>& values = phase.second;
+        std::sort(values.begin(), values.end());
+
+        double total = 0.0;
+        for (double v : values) total += v;
+
+        size_t p99 = std::min(values.size() - 1, (size_t)(0.99 * (double)(values.size() - 1) + 0.5));
+
+        summary.push_back(ProfileSummary{ phase.first, (int)values.size(), values.front(), total / values.size(), values[p99], values.back() });
+    }
+
+    return summary;
+}
+
+bool Profiler::dumpCsv(const char fileName[]) const
+{
+    std::ofstream file(fileName);
+    if (!file) return false;
+
+    file << std::fixed << std::setprecision(3);
+    file << "frame,phase,depth,start_us,duration_us\n";
+
+    for (int i = 0; i < count; i++)
+    {
+        const ProfileSample& sample = at(i);
+        file << sample.frame << ',' << sample.name << ',' << sample.depth << ',' << sample.start / 1000.0 << ',' << sample.duration / 1000.0 << '\n';
+    }
+
+    return (bool)file;
+}
+
+bool Profiler::dumpChromeTrace(const char fileName[]) const
+{
+    std::ofstream file(fileName);
+    if (!file) return false;
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"traceEvents\":[\n";
+
+    for (int i = 0; i < count; i++)
+    {
+        const ProfileSample& sample = at(i);
+
+        file << "{\"name\":\"" << sample.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+             << ",\"ts\":" << sample.start / 1000.0
+             << ",\"dur\":" << sample.duration / 1000.0
+             << ",\"args\":{\"frame\":" << sample.frame << "}}"
+             << ((i + 1 < count) ? ",\n" : "\n");
+    }
+
+    file << "],\"displayTimeUnit\":\"ms\"}\n";
+
+    return (bool)file;
+}
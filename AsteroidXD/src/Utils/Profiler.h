@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Instrumentation only exists when ASTEROIDXD_PROFILE is defined (Debug configuration).
+// Otherwise the macros expand to nothing and the release build pays zero cost.
+#ifdef ASTEROIDXD_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FRAME() Profiler::instance().nextFrame()
+#define PROFILE_SUSPEND() ProfileSuspend PROFILE_CONCAT(profileSuspend, __LINE__)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#define PROFILE_SUSPEND() ((void)0)
+#endif
+
+/// <summary>
+/// Una medicion: cuanto tardo una fase en un frame
+/// </summary>
+struct ProfileSample
+{
+    const char* name;
+    uint32_t frame;
+    uint32_t depth;
+    uint64_t start;
+    uint64_t duration;
+};
+
+/// <summary>
+/// Resumen de una fase sobre todas las mediciones del buffer, en milisegundos
+/// </summary>
+struct ProfileSummary
+{
+    std::string name;
+    int count;
+    double min;
+    double avg;
+    double p99;
+    double max;
+};
+
+/// <summary>
+/// Guarda las ultimas mediciones de PROFILE_SCOPE en un buffer circular
+/// y las exporta como CSV o como trace JSON de Chrome (chrome://tracing).
+/// Solo mide en el hilo principal: los PROFILE_SCOPE que corren en otros hilos no hacen nada.
+/// </summary>
+class Profiler
+{
+private:
+    static const int capacity = 1 << 16;
+
+    std::vector<ProfileSample> samples;
+    int head = 0;
+    int count = 0;
+    uint32_t frame = 0;
+    uint32_t depth = 0;
+    uint32_t suspended = 0;
+    uint64_t origin = 0;
+
+private:
+    Profiler();
+    const ProfileSample& at(int index) const;
+
+public:
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static Profiler& instance();
+
+    /// <summary>
+    /// Nanosegundos desde que se creo el profiler
+    /// </summary>
+    /// <returns></returns>
+    uint64_t now() const;
+
+    uint32_t enter();
+    void leave(const char* name, uint64_t start, uint32_t depth);
+    void nextFrame();
+    void clear();
+
+    /// <summary>
+    /// Mientras haya alguna suspension abierta no se mide nada, usar con PROFILE_SUSPEND
+    /// </summary>
+    void suspend();
+    void resume();
+
+    std::vector<ProfileSummary> summarize() const;
+    bool dumpCsv(const char fileName[]) const;
+    bool dumpChromeTrace(const char fileName[]) const;
+};
+
+/// <summary>
+/// Mide desde que se construye hasta que sale del scope, usar con PROFILE_SCOPE
+/// </summary>
+class ProfileScope
+{
+private:
+    const char* name;
+    uint32_t depth;
+    uint64_t start;
+
+public:
+    ProfileScope(const char* name) : name(name), depth(Profiler::instance().enter()), start(Profiler::instance().now()) { }
+    ~ProfileScope() { Profiler::instance().leave(name, start, depth); }
+};
+
+/// <summary>
+/// No mide nada hasta que sale del scope, usar con PROFILE_SUSPEND
+/// </summary>
+class ProfileSuspend
+{
+public:
+    ProfileSuspend() { Profiler::instance().suspend(); }
+    ~ProfileSuspend() { Profiler::instance().resume(); }
+};
@@ -0,0 +1,221 @@
+#pragma once
+#include <cstring>
+#include "Utils/Vector2Utils.h"
+
+// SSE2 is the baseline of every x86 target we build for (MSVC Win32 uses /arch:SSE2 by
+// default); AVX kicks in when the compiler is told to target it (/arch:AVX, -mavx)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define VECTOR2_BATCH_AVX 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VECTOR2_BATCH_SSE 1
+#endif
+
+// Batch versions of the Vector2Utils helpers over structure-of-arrays data (x[] and y[]).
+// Every lane does the same operations in the same order as the scalar helper, so the
+// results are bit for bit the ones of the scalar loop and replays stay deterministic.
+
+#pragma region BATCH HELPERS
+
+#if VECTOR2_BATCH_SSE
+// Four 0/1 bytes of a mask as 0.0f/1.0f lanes
+inline __m128 Vector2BatchLoadMask(const unsigned char* mask)
+{
+    int bytes;
+    memcpy(&bytes, mask, sizeof(bytes));
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i words = _mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero);
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero));
+}
+
+inline __m128 Vector2BatchSelect(__m128 condition, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(condition, a), _mm_andnot_ps(condition, b));
+}
+#endif
+
+/// <summary>
+/// x[i] += dx[i] * scale solo donde mask[i] es 1, el movimiento de todas las entidades
+/// </summary>
+/// <param name="x"></param>
+/// <param name="y"></param>
+/// <param name="dx">Velocidad en x</param>
+/// <param name="dy">Velocidad en y</param>
+/// <param name="mask">1 mueve, 0 deja quieto</param>
+/// <param name="scale">Normalmente el delta del tick</param>
+/// <param name="count"></param>
+inline void Vector2AddScaledMasked(float* x, float* y, const float* dx, const float* dy, const unsigned char* mask, float scale, int count)
+{
+    int i = 0;
+
+#if VECTOR2_BATCH_AVX
+    const __m256 scale8 = _mm256_set1_ps(scale);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 on = _mm256_insertf128_ps(_mm256_castps128_ps256(Vector2BatchLoadMask(mask + i)), Vector2BatchLoadMask(mask + i + 4), 1);
+        const __m256 step = _mm256_mul_ps(scale8, on);
+
+        _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(dx + i), step)));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(_mm256_loadu_ps(dy + i), step)));
+    }
+#endif
+
+#if VECTOR2_BATCH_SSE
+    const __m128 scale4 = _mm_set1_ps(scale);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 step = _mm_mul_ps(scale4, Vector2BatchLoadMask(mask + i));
+
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(dx + i), step)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(dy + i), step)));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        const float step = scale * (float)mask[i];
+        x[i] += dx[i] * step;
+        y[i] += dy[i] * step;
+    }
+}
+
+/// <summary>
+/// Normaliza todos los vectores, los de largo 0 quedan igual (como Vector2Normalize)
+/// </summary>
+/// <param name="x"></param>
+/// <param name="y"></param>
+/// <param name="count"></param>
+inline void Vector2NormalizeAll(float* x, float* y, int count)
+{
+    int i = 0;
+
+#if VECTOR2_BATCH_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 vx = _mm_loadu_ps(x + i);
+        const __m128 vy = _mm_loadu_ps(y + i);
+        const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+        const __m128 inverse = _mm_div_ps(one, length);
+        const __m128 valid = _mm_cmpgt_ps(length, zero);
+
+        _mm_storeu_ps(x + i, Vector2BatchSelect(valid, _mm_mul_ps(vx, inverse), vx));
+        _mm_storeu_ps(y + i, Vector2BatchSelect(valid, _mm_mul_ps(vy, inverse), vy));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        const Vector2 n = Vector2Normalize(Vector2{ x[i], y[i] });
+        x[i] = n.x;
+        y[i] = n.y;
+    }
+}
+
+/// <summary>
+/// Distancia al cuadrado de cada punto a point, para tests de colision sin raiz
+/// </summary>
+/// <param name="x"></param>
+/// <param name="y"></param>
+/// <param name="point"></param>
+/// <param name="out">count resultados</param>
+/// <param name="count"></param>
+inline void Vector2DistanceSqrAll(const float* x, const float* y, Vector2 point, float* out, int count)
+{
+    int i = 0;
+
+#if VECTOR2_BATCH_AVX
+    const __m256 px8 = _mm256_set1_ps(point.x);
+    const __m256 py8 = _mm256_set1_ps(point.y);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), px8);
+        const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), py8);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+    }
+#endif
+
+#if VECTOR2_BATCH_SSE
+    const __m128 px4 = _mm_set1_ps(point.x);
+    const __m128 py4 = _mm_set1_ps(point.y);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), px4);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), py4);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        const float dx = x[i] - point.x;
+        const float dy = y[i] - point.y;
+        out[i] = dx * dx + dy * dy;
+    }
+}
+
+/// <summary>
+/// Las posiciones con mask 1 que salen del rectangulo (0,0)-(width,height) mas su radio
+/// reaparecen del lado opuesto
+/// </summary>
+/// <param name="x"></param>
+/// <param name="y"></param>
+/// <param name="radius"></param>
+/// <param name="mask"></param>
+/// <param name="width"></param>
+/// <param name="height"></param>
+/// <param name="count"></param>
+inline void Vector2WrapMasked(float* x, float* y, const float* radius, const unsigned char* mask, float width, float height, int count)
+{
+    int i = 0;
+
+#if VECTOR2_BATCH_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 width4 = _mm_set1_ps(width);
+    const __m128 height4 = _mm_set1_ps(height);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 vx = _mm_loadu_ps(x + i);
+        const __m128 vy = _mm_loadu_ps(y + i);
+        const __m128 r = _mm_loadu_ps(radius + i);
+        const __m128 negativeR = _mm_xor_ps(r, sign);
+        const __m128 on = _mm_cmpgt_ps(Vector2BatchLoadMask(mask + i), zero);
+
+        const __m128 rightX = _mm_add_ps(width4, r);
+        const __m128 bottomY = _mm_add_ps(height4, r);
+
+        __m128 wrappedX = Vector2BatchSelect(_mm_cmplt_ps(vx, negativeR), rightX, vx);
+        wrappedX = Vector2BatchSelect(_mm_cmpgt_ps(vx, rightX), negativeR, wrappedX);
+
+        __m128 wrappedY = Vector2BatchSelect(_mm_cmplt_ps(vy, negativeR), bottomY, vy);
+        wrappedY = Vector2BatchSelect(_mm_cmpgt_ps(vy, bottomY), negativeR, wrappedY);
+
+        _mm_storeu_ps(x + i, Vector2BatchSelect(on, wrappedX, vx));
+        _mm_storeu_ps(y + i, Vector2BatchSelect(on, wrappedY, vy));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        const float r = radius[i];
+        const float wrappedX = (x[i] > width + r) ? -r : ((x[i] < -r) ? width + r : x[i]);
+        const float wrappedY = (y[i] > height + r) ? -r : ((y[i] < -r) ? height + r : y[i]);
+
+        x[i] = mask[i] ? wrappedX : x[i];
+        y[i] = mask[i] ? wrappedY : y[i];
+    }
+}
+
+#pragma endregion
@@ -2,9 +2,27 @@
 #include <cmath>
 #include "raylib.h"
 
+// Header only: every helper is inline (constexpr where it only does arithmetic)
+// so calls from Ship, the simulation or the batch loops can be inlined
+
 #pragma region VECTOR2 HELPERS
 
-float Clamp(float value, float min, float max);
+constexpr float Clamp(float value, float min, float max)
+{
+    const float res = value < min ? min : value;
+    return res > max ? max : res;
+}
+
+/// <summary>
+/// Desplazamiento mas corto en un eje de una pantalla que da la vuelta
+/// </summary>
+/// <param name="delta">Diferencia de posiciones, dentro de (-size, size)</param>
+/// <param name="size">Ancho o alto de la pantalla</param>
+/// <returns></returns>
+constexpr float WrappedDelta(float delta, float size)
+{
+    return (delta > size * 0.5f) ? delta - size : ((delta < -size * 0.5f) ? delta + size : delta);
+}
 
 /// <summary>
 /// Angulo que se genera con 2 vetores
@@ -12,7 +30,12 @@ float Clamp(float value, float min, float max);
 /// <param name="v1"></param>
 /// <param name="v2"></param>
 /// <returns></returns>
-float Vector2Angle(Vector2 v1, Vector2 v2);
+inline float Vector2Angle(Vector2 v1, Vector2 v2)
+{
+    float result = atan2f(v2.y - v1.y, v2.x - v1.x) * (180.0f / PI);
+    if (result < 0) result += 360.0f;
+    return result;
+}
 
 /// <summary>
 /// Calcula la distancia entre 2 vectores
@@ -20,14 +43,20 @@ float Vector2Angle(Vector2 v1, Vector2 v2);
 /// <param name="v1"></param>
 /// <param name="v2"></param>
 /// <returns></returns>
-float Vector2Distance(Vector2 v1, Vector2 v2);
+inline float Vector2Distance(Vector2 v1, Vector2 v2)
+{
+    return sqrtf((v1.x - v2.x) * (v1.x - v2.x) + (v1.y - v2.y) * (v1.y - v2.y));
+}
 
 /// <summary>
 /// El largo del vector o la magnitud
 /// </summary>
 /// <param name="v"></param>
 /// <returns></returns>
-float Vector2Length(Vector2 v);
+inline float Vector2Length(Vector2 v)
+{
+    return sqrtf((v.x * v.x) + (v.y * v.y));
+}
 
 /// <summary>
 /// Escalar el vector
@@ -35,18 +64,34 @@ float Vector2Length(Vector2 v);
 /// <param name="v"></param>
 /// <param name="scale"></param>
 /// <returns></returns>
-Vector2 Vector2Scale(Vector2 v, float scale);
+constexpr Vector2 Vector2Scale(Vector2 v, float scale)
+{
+    return Vector2{ v.x * scale, v.y * scale };
+}
 
-Vector2 Vector2Multiply(Vector2 v1, Vector2 v2);
+constexpr Vector2 Vector2Multiply(Vector2 v1, Vector2 v2)
+{
+    return Vector2{ v1.x * v2.x, v1.y * v2.y };
+}
 
 /// <summary>
 /// Normalizar el vector
 /// </summary>
 /// <param name="v"></param>
 /// <returns></returns>
-Vector2 Vector2Normalize(Vector2 v);
+inline Vector2 Vector2Normalize(Vector2 v)
+{
+    float length = Vector2Length(v);
+    if (length <= 0)
+        return v;
+
+    return Vector2Scale(v, 1 / length);
+}
 
-Vector2 Vector2Add(Vector2 v1, Vector2 v2);
+constexpr Vector2 Vector2Add(Vector2 v1, Vector2 v2)
+{
+    return Vector2{ v1.x + v2.x, v1.y + v2.y };
+}
 
 /// <summary>
 /// Resta entre 2 vectores
@@ -54,6 +99,9 @@ Vector2 Vector2Add(Vector2 v1, Vector2 v2);
 /// <param name="v1"></param>
 /// <param name="v2"></param>
 /// <returns></returns>
-Vector2 Vector2Subtract(Vector2 v1, Vector2 v2);
+constexpr Vector2 Vector2Subtract(Vector2 v1, Vector2 v2)
+{
+    return Vector2{ v1.x - v2.x, v1.y - v2.y };
+}
 
 #pragma endregion
\ No newline at end of file
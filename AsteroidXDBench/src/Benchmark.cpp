@@ -0,0 +1,54 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdio>
+
+volatile float benchmarkSink = 0.0f;
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions& options) : options(options) { }
+
+const BenchmarkOptions& BenchmarkRunner::getOptions() const
+{
+    return options;
+}
+
+bool BenchmarkRunner::isSelected(const char* name) const
+{
+    return options.filter.empty() || std::string(name).find(options.filter) != std::string::npos;
+}
+
+void BenchmarkRunner::addResult(const char* name, int count, long long iterations, std::vector<double>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+
+    results.push_back(BenchmarkResult{ name, count, iterations, samples[samples.size() / 2], samples.front(), samples.back() });
+
+    // Progress goes to stderr so stdout stays machine readable
+    fprintf(stderr, "%-36s %8i %12.3f ns/op\n", name, count, samples[samples.size() / 2]);
+}
+
+void BenchmarkRunner::print() const
+{
+    if (options.json)
+    {
+        printf("{\"benchmarks\":[\n");
+
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const BenchmarkResult& r = results[i];
+
+            printf("{\"name\":\"%s\",\"count\":%i,\"iterations\":%lld,\"ns_per_op\":%.4f,\"min_ns_per_op\":%.4f,\"max_ns_per_op\":%.4f}%s\n",
+                r.name.c_str(), r.count, r.iterations, r.nsPerOp, r.minNsPerOp, r.maxNsPerOp,
+                (i + 1 < results.size()) ? "," : "");
+        }
+
+        printf("]}\n");
+        return;
+    }
+
+    printf("benchmark,count,iterations,ns_per_op,min_ns_per_op,max_ns_per_op\n");
+
+    for (const BenchmarkResult& r : results)
+    {
+        printf("%s,%i,%lld,%.4f,%.4f,%.4f\n", r.name.c_str(), r.count, r.iterations, r.nsPerOp, r.minNsPerOp, r.maxNsPerOp);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Resultado de un benchmark, los tiempos son nanosegundos por operacion
+/// </summary>
+struct BenchmarkResult
+{
+    std::string name;
+    int count;
+    long long iterations;
+    double nsPerOp;
+    double minNsPerOp;
+    double maxNsPerOp;
+};
+
+/// <summary>
+/// Opciones de la corrida, se leen de la linea de comandos
+/// </summary>
+struct BenchmarkOptions
+{
+    // Every sample runs the body at least this long, the reported time is the median sample
+    double minSampleSeconds = 0.02;
+    int samples = 7;
+    bool quick = false;
+    bool json = false;
+    std::string filter;
+};
+
+/// <summary>
+/// Escribir el resultado aca evita que el optimizador borre el trabajo medido
+/// </summary>
+extern volatile float benchmarkSink;
+
+/// <summary>
+/// Mide cuerpos de benchmark y junta los resultados para imprimirlos al final
+/// </summary>
+class BenchmarkRunner
+{
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    BenchmarkOptions options;
+    std::vector<BenchmarkResult> results;
+
+    void addResult(const char* name, int count, long long iterations, std::vector<double>& samples);
+
+public:
+    BenchmarkRunner(const BenchmarkOptions& options);
+
+    const BenchmarkOptions& getOptions() const;
+    bool isSelected(const char* name) const;
+
+    /// <summary>
+    /// Corre body(iterations) hasta que cada muestra dure minSampleSeconds.
+    /// Cada iteracion cuenta como opsPerIteration operaciones.
+    /// </summary>
+    /// <param name="name">Nombre del benchmark, grupo/caso</param>
+    /// <param name="count">Cantidad de entidades del caso</param>
+    /// <param name="opsPerIteration">Operaciones que hace una iteracion del cuerpo</param>
+    /// <param name="body">Recibe la cantidad de iteraciones a correr</param>
+    template<typename Body>
+    void run(const char* name, int count, int opsPerIteration, Body&& body)
+    {
+        if (!isSelected(name)) return;
+
+        // Warm up caches and find an iteration count that fills a sample
+        long long iterations = 1;
+
+        for (;;)
+        {
+            Clock::time_point start = Clock::now();
+            body(iterations);
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            if (seconds >= options.minSampleSeconds) break;
+
+            iterations *= (seconds < options.minSampleSeconds / 16.0) ? 8 : 2;
+        }
+
+        std::vector<double> samples;
+
+        for (int s = 0; s < options.samples; s++)
+        {
+            Clock::time_point start = Clock::now();
+            body(iterations);
+            double nanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+            samples.push_back(nanoseconds / ((double)iterations * opsPerIteration));
+        }
+
+        addResult(name, count, iterations, samples);
+    }
+
+    /// <summary>
+    /// Imprime los resultados en CSV o JSON por la salida estandar
+    /// </summary>
+    void print() const;
+};
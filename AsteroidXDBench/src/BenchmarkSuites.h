@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Benchmark.h"
+#include "Utils/Vector2Utils.h"
+
+/// <summary>
+/// Puntos al azar dentro de [min, max) en cada eje, siempre los mismos para la misma semilla
+/// </summary>
+std::vector<Vector2> RandomVectors(int count, float min, float max, uint64_t seed);
+
+/// <summary>
+/// Cantidades de entidades de cada caso, menos con --quick
+/// </summary>
+std::vector<int> EntityCounts(const BenchmarkRunner& runner, std::vector<int> full, std::vector<int> quick);
+
+void RunVector2Benchmarks(BenchmarkRunner& runner);
+void RunCollisionBenchmarks(BenchmarkRunner& runner);
+void RunMeteorBenchmarks(BenchmarkRunner& runner);
+void RunEnvBenchmarks(BenchmarkRunner& runner);
+void RunSensorBenchmarks(BenchmarkRunner& runner);
@@ -0,0 +1,141 @@
+#include "BenchmarkSuites.h"
+#include "Simulation/MeteorField.h"
+#include "Simulation/SpatialHash.h"
+#include "Utils/Vector2Batch.h"
+
+static const float fieldWidth = 1024.0f;
+static const float fieldHeight = 720.0f;
+
+// Same test as raylib CheckCollisionCircles, with the square root
+static bool CheckCollisionCirclesSqrt(Vector2 center1, float radius1, Vector2 center2, float radius2)
+{
+    float dx = center2.x - center1.x;
+    float dy = center2.y - center1.y;
+
+    return sqrtf(dx * dx + dy * dy) <= (radius1 + radius2);
+}
+
+// Same test the simulation uses, squared distances only
+static bool CheckCollisionCirclesSquared(Vector2 center1, float radius1, Vector2 center2, float radius2)
+{
+    float dx = center2.x - center1.x;
+    float dy = center2.y - center1.y;
+    float radii = radius1 + radius2;
+
+    return (dx * dx + dy * dy) <= radii * radii;
+}
+
+static MeteorField RandomField(int count)
+{
+    const std::vector<Vector2> positions = RandomVectors(count, 0.0f, fieldWidth, 3);
+    const std::vector<Vector2> speeds = RandomVectors(count, -150.0f, 150.0f, 4);
+
+    MeteorField field;
+    field.reset(count);
+
+    for (int i = 0; i < count; i++)
+    {
+        Vector2 position{ positions[i].x, positions[i].y * fieldHeight / fieldWidth };
+        field.spawn(position, speeds[i], (i % 3 == 0) ? 40.0f : 20.0f, 0.0f, 0);
+    }
+
+    return field;
+}
+
+void RunCollisionBenchmarks(BenchmarkRunner& runner)
+{
+    for (int count : EntityCounts(runner, { 1024, 65536 }, { 1024 }))
+    {
+        const std::vector<Vector2> a = RandomVectors(count, 0.0f, fieldWidth, 5);
+        const std::vector<Vector2> b = RandomVectors(count, 0.0f, fieldWidth, 6);
+
+        runner.run("collision/circles_sqrt", count, count, [&](long long iterations)
+        {
+            int hits = 0;
+            for (long long it = 0; it < iterations; it++)
+                for (int i = 0; i < count; i++) hits += CheckCollisionCirclesSqrt(a[i], 40.0f, b[i], 18.0f);
+            benchmarkSink = (float)hits;
+        });
+
+        runner.run("collision/circles_squared", count, count, [&](long long iterations)
+        {
+            int hits = 0;
+            for (long long it = 0; it < iterations; it++)
+                for (int i = 0; i < count; i++) hits += CheckCollisionCirclesSquared(a[i], 40.0f, b[i], 18.0f);
+            benchmarkSink = (float)hits;
+        });
+    }
+
+    // Ship and shoots against the whole field: brute force vs the grid broadphase
+    const int queries = 64;
+    const std::vector<Vector2> queryCenters = RandomVectors(queries, 0.0f, fieldHeight, 7);
+
+    for (int count : EntityCounts(runner, { 1000, 10000, 100000 }, { 1000, 10000 }))
+    {
+        const MeteorField field = RandomField(count);
+
+        SpatialHash grid;
+        grid.configure(fieldWidth, fieldHeight, 80.0f);
+
+        runner.run("collision/broadphase_build", count, count, [&](long long iterations)
+        {
+            for (long long it = 0; it < iterations; it++) grid.build(field);
+            benchmarkSink = (float)grid.getColumns();
+        });
+
+        grid.build(field);
+
+        runner.run("collision/query_brute", count, queries, [&](long long iterations)
+        {
+            int hits = 0;
+            for (long long it = 0; it < iterations; it++)
+            {
+                for (const Vector2& center : queryCenters)
+                {
+                    for (int i = 0; i < field.size(); i++)
+                    {
+                        if (field.active[i] && CheckCollisionCirclesSquared(center, 18.0f, field.getPosition(i), field.radius[i])) hits++;
+                    }
+                }
+            }
+            benchmarkSink = (float)hits;
+        });
+
+        std::vector<float> distances(field.size());
+
+        runner.run("collision/query_brute_batch", count, queries, [&](long long iterations)
+        {
+            int hits = 0;
+            for (long long it = 0; it < iterations; it++)
+            {
+                for (const Vector2& center : queryCenters)
+                {
+                    Vector2DistanceSqrAll(field.positionX.data(), field.positionY.data(), center, distances.data(), field.size());
+
+                    for (int i = 0; i < field.size(); i++)
+                    {
+                        const float radii = 18.0f + field.radius[i];
+                        hits += (field.active[i] && distances[i] <= radii * radii);
+                    }
+                }
+            }
+            benchmarkSink = (float)hits;
+        });
+
+        runner.run("collision/query_grid", count, queries, [&](long long iterations)
+        {
+            int hits = 0;
+            for (long long it = 0; it < iterations; it++)
+            {
+                for (const Vector2& center : queryCenters)
+                {
+                    grid.query(center, 18.0f, [&](int i)
+                    {
+                        if (CheckCollisionCirclesSquared(center, 18.0f, field.getPosition(i), field.radius[i])) hits++;
+                    });
+                }
+            }
+            benchmarkSink = (float)hits;
+        });
+    }
+}
@@ -0,0 +1,73 @@
+#include "BenchmarkSuites.h"
+#include "Simulation/Random.h"
+#include "Simulation/RaySensor.h"
+#include "Simulation/VecEnv.h"
+
+void RunEnvBenchmarks(BenchmarkRunner& runner)
+{
+    // count is the amount of environments and an op is one env-step, so ns_per_op gives env-steps per second
+    for (int count : EntityCounts(runner, { 64, 1024, 4096 }, { 64, 512 }))
+    {
+        if (!runner.isSelected("vecenv/step")) continue;
+
+        VecEnvConfig config;
+        config.envs = count;
+        config.seed = 77;
+
+        VecEnv env(config);
+
+        // Random actions drawn up front, a batch per step cycling through a few batches
+        const int batches = 16;
+        std::vector<float> actions((size_t)batches * count * VecEnv::actionSize);
+        Random random(5, 1);
+
+        for (size_t i = 0; i < actions.size(); i += VecEnv::actionSize)
+        {
+            actions[i] = (float)random.range(0, 628) / 100.0f;
+            actions[i + 1] = (float)random.range(-1, 1);
+            actions[i + 2] = random.range(0, 7) == 0 ? 1.0f : 0.0f;
+        }
+
+        long long batch = 0;
+
+        runner.run("vecenv/step", count, count, [&](long long iterations)
+        {
+            for (long long it = 0; it < iterations; it++)
+            {
+                env.step(actions.data() + (size_t)(batch++ % batches) * count * VecEnv::actionSize);
+            }
+            benchmarkSink = env.getObservations()[0] + env.getRewards()[count - 1];
+        });
+    }
+}
+
+void RunSensorBenchmarks(BenchmarkRunner& runner)
+{
+    // A level 20 field in mid play, count is the amount of rays and an op is one ray
+    for (int count : EntityCounts(runner, { 8, 32, 128 }, { 8, 32 }))
+    {
+        if (!runner.isSelected("sensor/raycast")) continue;
+
+        SimConfig config;
+        Simulation simulation(config);
+        simulation.reset(20, 99);
+
+        SimInput input;
+        input.aim = Vector2{ config.width, config.height * 0.5f };
+
+        for (int tick = 0; tick < 120; tick++) simulation.step(input, 1.0f / 60.0f);
+
+        RaySensor sensor(count, 300.0f, config);
+        std::vector<float> meteorHits(count);
+        std::vector<float> powerUpHits(count);
+
+        runner.run("sensor/raycast", count, count, [&](long long iterations)
+        {
+            for (long long it = 0; it < iterations; it++)
+            {
+                sensor.cast(simulation, 0, meteorHits.data(), powerUpHits.data());
+            }
+            benchmarkSink = meteorHits[0] + powerUpHits[count - 1];
+        });
+    }
+}
@@ -0,0 +1,75 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "BenchmarkSuites.h"
+#include "Simulation/Random.h"
+#include "Utils/JobSystem.h"
+
+static const char usageText[] = R"(
+AsteroidXDBench [--quick] [--json] [--filter text] [--threads n]
+
+  --quick        menos entidades y muestras mas cortas (CI)
+  --json         imprime JSON en lugar de CSV
+  --filter text  corre solo los benchmarks cuyo nombre contiene text
+  --threads n    workers del JobSystem ademas del hilo principal (por defecto uno por core)
+)";
+
+std::vector<Vector2> RandomVectors(int count, float min, float max, uint64_t seed)
+{
+    Random random(seed, 1);
+    std::vector<Vector2> vectors(count);
+
+    // Thousandths of a unit are enough resolution for positions and speeds
+    for (Vector2& v : vectors)
+    {
+        v.x = min + (max - min) * (float)random.range(0, 999999) / 1000000.0f;
+        v.y = min + (max - min) * (float)random.range(0, 999999) / 1000000.0f;
+    }
+
+    return vectors;
+}
+
+std::vector<int> EntityCounts(const BenchmarkRunner& runner, std::vector<int> full, std::vector<int> quick)
+{
+    return runner.getOptions().quick ? quick : full;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions options;
+    int workers = -1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--quick") == 0)
+        {
+            options.quick = true;
+            options.minSampleSeconds = 0.005;
+            options.samples = 3;
+        }
+        else if (strcmp(argv[i], "--json") == 0) options.json = true;
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) options.filter = argv[++i];
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) workers = atoi(argv[++i]);
+        else
+        {
+            fprintf(stderr, "%s", usageText);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    JobSystem::instance().start(workers);
+    fprintf(stderr, "job system workers: %i\n", JobSystem::instance().getWorkerCount());
+
+    BenchmarkRunner runner(options);
+
+    RunVector2Benchmarks(runner);
+    RunCollisionBenchmarks(runner);
+    RunMeteorBenchmarks(runner);
+    RunEnvBenchmarks(runner);
+    RunSensorBenchmarks(runner);
+
+    runner.print();
+
+    JobSystem::instance().stop();
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "BenchmarkSuites.h"
+#include "Simulation/MeteorField.h"
+#include "Simulation/Simulation.h"
+#include "Utils/JobSystem.h"
+
+static const float fieldWidth = 1024.0f;
+static const float fieldHeight = 720.0f;
+static const float tickStep = 1.0f / 120.0f;
+
+/// <summary>
+/// Un meteoro como objeto, el layout que tenia Meteor antes de MeteorField
+/// </summary>
+struct MeteorObject
+{
+    Vector2 position;
+    Vector2 speed;
+    float radius;
+    float rotation;
+    bool active;
+};
+
+void RunMeteorBenchmarks(BenchmarkRunner& runner)
+{
+    for (int count : EntityCounts(runner, { 1000, 10000, 100000 }, { 1000, 10000 }))
+    {
+        const std::vector<Vector2> positions = RandomVectors(count, 0.0f, fieldWidth, 8);
+        const std::vector<Vector2> speeds = RandomVectors(count, -150.0f, 150.0f, 9);
+
+        MeteorField field;
+        field.reset(count);
+        std::vector<MeteorObject> objects(count);
+
+        for (int i = 0; i < count; i++)
+        {
+            field.spawn(positions[i], speeds[i], 40.0f, 0.0f, 0);
+            objects[i] = MeteorObject{ positions[i], speeds[i], 40.0f, 0.0f, i % 8 != 0 };
+        }
+
+        // One in eight meteors inactive, like a level where some were destroyed
+        for (int i = 0; i < count; i += 8) field.despawn(i);
+
+        runner.run("meteors/field_move_wrap", count, count, [&](long long iterations)
+        {
+            for (long long it = 0; it < iterations; it++)
+            {
+                field.move(tickStep);
+                field.wrap(fieldWidth, fieldHeight);
+            }
+            benchmarkSink = field.positionX[count - 1];
+        });
+
+        runner.run("meteors/field_move_wrap_jobs", count, count, [&](long long iterations)
+        {
+            for (long long it = 0; it < iterations; it++)
+            {
+                JobSystem::instance().parallelFor(count, 16384, [&](int begin, int end)
+                {
+                    field.move(tickStep, begin, end);
+                    field.wrap(fieldWidth, fieldHeight, begin, end);
+                });
+            }
+            benchmarkSink = field.positionX[count - 1];
+        });
+
+        runner.run("meteors/object_move_wrap", count, count, [&](long long iterations)
+        {
+            for (long long it = 0; it < iterations; it++)
+            {
+                for (MeteorObject& m : objects)
+                {
+                    if (!m.active) continue;
+
+                    m.position = Vector2Add(m.position, Vector2Scale(m.speed, tickStep));
+
+                    if (m.position.x > fieldWidth + m.radius) m.position.x = -m.radius;
+                    else if (m.position.x < -m.radius) m.position.x = fieldWidth + m.radius;
+                    if (m.position.y > fieldHeight + m.radius) m.position.y = -m.radius;
+                    else if (m.position.y < -m.radius) m.position.y = fieldHeight + m.radius;
+                }
+            }
+            benchmarkSink = objects[count - 1].position.x;
+        });
+    }
+
+    // Whole ticks in stress mode, count is the amount of big meteors and an op is one tick
+    for (int count : EntityCounts(runner, { 100, 1000, 10000 }, { 100, 1000 }))
+    {
+        SimConfig config;
+        config.stressMeteors = count;
+        config.shipMaxShield = 1 << 30;     // The ship must survive every sample
+
+        Simulation simulation(config);
+        simulation.reset(1, 1234);
+
+        SimInput input;
+        input.aim = Vector2{ 0.0f, 0.0f };
+        input.thrust = true;
+
+        runner.run("simulation/step", count, 1, [&](long long iterations)
+        {
+            for (long long it = 0; it < iterations; it++)
+            {
+                input.fire = (simulation.getTick() % 30) == 0;
+                simulation.step(input, tickStep);
+            }
+            benchmarkSink = simulation.getShip().position.x;
+        });
+
+        // Snapshot of the world after those ticks, an op is one save or one load
+        std::vector<unsigned char> snapshot(simulation.getSnapshotSize());
+
+        runner.run("simulation/snapshot_save", count, 1, [&](long long iterations)
+        {
+            for (long long it = 0; it < iterations; it++) simulation.saveSnapshot(snapshot.data(), snapshot.size());
+            benchmarkSink = snapshot[snapshot.size() - 1];
+        });
+
+        runner.run("simulation/snapshot_load", count, 1, [&](long long iterations)
+        {
+            for (long long it = 0; it < iterations; it++) simulation.loadSnapshot(snapshot.data(), snapshot.size());
+            benchmarkSink = simulation.getShip().position.x;
+        });
+    }
+}
@@ -0,0 +1,98 @@
+#include "BenchmarkSuites.h"
+#include "Utils/Vector2Batch.h"
+
+void RunVector2Benchmarks(BenchmarkRunner& runner)
+{
+    for (int count : EntityCounts(runner, { 1024, 65536 }, { 1024 }))
+    {
+        const std::vector<Vector2> a = RandomVectors(count, -512.0f, 512.0f, 1);
+        const std::vector<Vector2> b = RandomVectors(count, -512.0f, 512.0f, 2);
+
+        runner.run("vector2/length", count, count, [&](long long iterations)
+        {
+            float sum = 0.0f;
+            for (long long it = 0; it < iterations; it++)
+                for (int i = 0; i < count; i++) sum += Vector2Length(a[i]);
+            benchmarkSink = sum;
+        });
+
+        runner.run("vector2/distance", count, count, [&](long long iterations)
+        {
+            float sum = 0.0f;
+            for (long long it = 0; it < iterations; it++)
+                for (int i = 0; i < count; i++) sum += Vector2Distance(a[i], b[i]);
+            benchmarkSink = sum;
+        });
+
+        runner.run("vector2/normalize", count, count, [&](long long iterations)
+        {
+            float sum = 0.0f;
+            for (long long it = 0; it < iterations; it++)
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    Vector2 n = Vector2Normalize(a[i]);
+                    sum += n.x + n.y;
+                }
+            }
+            benchmarkSink = sum;
+        });
+
+        runner.run("vector2/angle", count, count, [&](long long iterations)
+        {
+            float sum = 0.0f;
+            for (long long it = 0; it < iterations; it++)
+                for (int i = 0; i < count; i++) sum += Vector2Angle(a[i], b[i]);
+            benchmarkSink = sum;
+        });
+
+        runner.run("vector2/clamp", count, count, [&](long long iterations)
+        {
+            float sum = 0.0f;
+            for (long long it = 0; it < iterations; it++)
+                for (int i = 0; i < count; i++) sum += Clamp(a[i].x, -100.0f, 100.0f);
+            benchmarkSink = sum;
+        });
+
+        // position += velocity * dt, the movement of every entity
+        std::vector<Vector2> positions = a;
+
+        runner.run("vector2/add_scaled", count, count, [&](long long iterations)
+        {
+            for (long long it = 0; it < iterations; it++)
+                for (int i = 0; i < count; i++) positions[i] = Vector2Add(positions[i], Vector2Scale(b[i], 1.0f / 120.0f));
+            benchmarkSink = positions[count - 1].x;
+        });
+
+        // Same work over structure-of-arrays data with the batch helpers
+        std::vector<float> x(count), y(count), dx(count), dy(count);
+        const std::vector<unsigned char> mask(count, 1);
+
+        for (int i = 0; i < count; i++)
+        {
+            x[i] = a[i].x;
+            y[i] = a[i].y;
+            dx[i] = b[i].x;
+            dy[i] = b[i].y;
+        }
+
+        runner.run("vector2/add_scaled_batch", count, count, [&](long long iterations)
+        {
+            for (long long it = 0; it < iterations; it++) Vector2AddScaledMasked(x.data(), y.data(), dx.data(), dy.data(), mask.data(), 1.0f / 120.0f, count);
+            benchmarkSink = x[count - 1];
+        });
+
+        std::vector<float> nx(count), ny(count);
+
+        runner.run("vector2/normalize_batch", count, count, [&](long long iterations)
+        {
+            for (long long it = 0; it < iterations; it++)
+            {
+                nx = dx;
+                ny = dy;
+                Vector2NormalizeAll(nx.data(), ny.data(), count);
+            }
+            benchmarkSink = nx[count - 1];
+        });
+    }
+}